@@ -0,0 +1,71 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "hashkit.h"
+
+//
+// Throughput of the hash kernels, short keys (routing) and long buffers
+//
+//   bench_hashkit [rounds]
+//
+
+static volatile uint64_t sink = 0;
+
+void bench(const std::string &name, const std::vector<std::string> &inputs, int rounds,
+           const std::function<uint64_t(const std::string &)> &hash) {
+    size_t bytes = 0;
+    for (auto &input : inputs)
+        bytes += input.size();
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t acc = 0;
+    for (int r = 0; r < rounds; ++r) {
+        for (auto &input : inputs)
+            acc += hash(input);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink += acc;
+
+    double calls = (double) inputs.size() * rounds;
+    std::cout << std::left << std::setw(16) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << seconds * 1e9 / calls << " ns/hash"
+              << std::setw(10) << bytes * rounds / seconds / (1 << 20) << " MB/s" << std::endl;
+}
+
+void bench_all(const std::string &title, const std::vector<std::string> &inputs, int rounds) {
+    std::cout << "\n------ " << title << " ----------\n";
+
+    bench("murmur2", inputs, rounds, [](const std::string &s) { return hash_murmur(s.data(), s.size()); });
+    bench("xxh64", inputs, rounds, [](const std::string &s) { return hash_xxh64(s.data(), s.size()); });
+    bench("murmur3_128", inputs, rounds, [](const std::string &s) {
+        uint64_t out[2];
+        hash_murmur3_128(s.data(), s.size(), 0, out);
+        return out[0] ^ out[1];
+    });
+    bench("crc32c", inputs, rounds, [](const std::string &s) { return hash_crc32c(s.data(), s.size()); });
+    bench("crc32c_soft", inputs, rounds, [](const std::string &s) { return hash_crc32c_soft(s.data(), s.size()); });
+}
+
+int main(int argc, const char *argv[]) {
+    int rounds = 20;
+    if (argc > 1)
+        rounds = std::atoi(argv[1]);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 100000; ++i)
+        keys.push_back("player-" + std::to_string(i));
+    bench_all("short keys", keys, rounds);
+
+    std::vector<std::string> buffers;
+    for (int i = 0; i < 64; ++i)
+        buffers.push_back(std::string(64 * 1024, (char) i));
+    bench_all("64KB buffers", buffers, rounds);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pool_sharding.h"
+
+//
+// Routing overhead: key -> shard id -> pool -> connection
+//
+//   bench_sharding [shardnum] [rounds]
+//
+
+struct DummyConnection {
+    int shard() const { return shard_; }
+
+    int shard_ = -1;
+};
+
+struct DummyPool {
+    explicit DummyPool(int shard) { connection_.shard_ = shard; }
+
+    int shard() const { return connection_.shard(); }
+
+    DummyConnection *acquire(PoolPriority) { return &connection_; }
+
+    void putback(const DummyConnection *) {}
+
+    DummyConnection connection_;
+};
+
+static volatile uintptr_t sink = 0;
+
+template<typename F>
+void bench(const std::string &name, size_t calls, F &&op) {
+    auto start = std::chrono::steady_clock::now();
+    uintptr_t acc = 0;
+    for (size_t i = 0; i < calls; ++i)
+        acc += op(i);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink += acc;
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(8) << std::fixed << std::setprecision(2)
+              << seconds * 1e9 / calls << " ns/op" << std::endl;
+}
+
+int main(int argc, const char *argv[]) {
+    int shardnum = argc > 1 ? std::atoi(argv[1]) : 16;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    ShardingConnectionPool<DummyConnection, DummyPool> sharding(shardnum);
+    std::map<int, DummyPool *> baseline;
+    std::vector<DummyPool *> pools;
+    for (int i = 0; i < shardnum; ++i) {
+        pools.push_back(new DummyPool(i));
+        sharding.addShard(pools.back());
+        baseline[i] = pools.back();
+    }
+
+    std::vector<std::string> keys;
+    std::vector<uint32_t> hashes;
+    for (int i = 0; i < 100000; ++i) {
+        keys.push_back("player-" + std::to_string(i));
+        hashes.push_back(MurmurHash::hash(keys.back()));
+    }
+
+    size_t calls = keys.size() * rounds;
+    size_t mask = keys.size();
+
+    std::cout << "shards: " << shardnum << std::endl;
+
+    bench("shardIDByHash", calls, [&](size_t i) {
+        return (uintptr_t) sharding.shardIDByHash(hashes[i % mask]);
+    });
+
+    bench("std::map find (before)", calls, [&](size_t i) {
+        return (uintptr_t) baseline.find((int) (hashes[i % mask] % shardnum))->second;
+    });
+
+    bench("getShardByID", calls, [&](size_t i) {
+        return (uintptr_t) sharding.getShardByID((int) (hashes[i % mask] % shardnum));
+    });
+
+    bench("getShardByHash", calls, [&](size_t i) {
+        return (uintptr_t) sharding.getShardByHash(hashes[i % mask]);
+    });
+
+    bench("acquireByHash + putback", calls, [&](size_t i) {
+        DummyConnection *conn = sharding.acquireByHash(hashes[i % mask]);
+        sharding.putback(conn);
+        return (uintptr_t) conn;
+    });
+
+    bench("acquireByKey + putback", calls, [&](size_t i) {
+        DummyConnection *conn = sharding.acquireByKey(keys[i % mask]);
+        sharding.putback(conn);
+        return (uintptr_t) conn;
+    });
+
+    for (auto pool : pools)
+        delete pool;
+    return 0;
+}
@@ -155,7 +155,8 @@ RUN_ONCE(Player) {
             .field(&Player::weapon, "OBJ1", FieldType::OBJECT)
             .field(&Player::weapons, "OBJ2", FieldType::OBJECT)
             .key("ID")
-            .index("NAME");
+            .index("NAME")
+            .shardKey("ID");
 }
 
 std::ostream &operator<<(std::ostream &os, const Player &p) {
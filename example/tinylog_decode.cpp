@@ -0,0 +1,179 @@
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+
+#include "tinylogger.h"
+
+//
+// Renders a binary log of SimpleLogger (kFormat_Binary) as text:
+//
+//   tinylog_decode server.blog [-v] > server.log
+//
+//   -v : append the call site (file:line) to every line
+//
+
+struct Site {
+    int level = 0;
+    std::string logger;
+    std::string file;
+    uint64_t line = 0;
+    std::string fmt;
+};
+
+class Reader {
+public:
+    Reader(const std::string &data) : p_(data.data()), end_(data.data() + data.size()) {}
+
+    bool eof() const { return p_ >= end_; }
+
+    bool byte(int &b) {
+        if (p_ >= end_) return false;
+        b = (unsigned char) *p_++;
+        return true;
+    }
+
+    bool varint(uint64_t &v) {
+        v = 0;
+        for (int shift = 0; p_ < end_ && shift < 64; shift += 7) {
+            uint8_t b = (uint8_t) *p_++;
+            v |= (uint64_t) (b & 0x7f) << shift;
+            if (!(b & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool time(int64_t &last) {
+        uint64_t v = 0;
+        if (!varint(v)) return false;
+        last += (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+        return true;
+    }
+
+    bool bytes(std::string &s, uint64_t size) {
+        if ((uint64_t) (end_ - p_) < size) return false;
+        s.assign(p_, (size_t) size);
+        p_ += size;
+        return true;
+    }
+
+    bool string(std::string &s) {
+        uint64_t size = 0;
+        return varint(size) && bytes(s, size);
+    }
+
+private:
+    const char *p_;
+    const char *end_;
+};
+
+static void print(int64_t time, int level, const std::string &logger, const std::string &text,
+                  const Site *site = nullptr) {
+    static int64_t cached_second = -1;
+    static char secondstr[32] = "";
+
+    if (time / 1000 != cached_second) {
+        cached_second = time / 1000;
+        std::time_t t = (std::time_t) cached_second;
+        std::strftime(secondstr, sizeof(secondstr), "%Y-%m-%d %H:%M:%S", std::localtime(&t));
+    }
+
+    printf("%s.%03d %5s: [%s] - %s", secondstr, (int) (time % 1000),
+           SimpleLogger::instance().level_name(level), logger.c_str(), text.c_str());
+    if (site)
+        printf("  (%s:%llu)", site->file.c_str(), (unsigned long long) site->line);
+    printf("\n");
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage:" << argv[0] << " binary-log-file [-v]" << std::endl;
+        return 1;
+    }
+
+    bool verbose = (argc > 2 && std::string(argv[2]) == "-v");
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Can't open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Reader reader(data);
+
+    std::map<uint64_t, Site> sites;
+    int64_t time = 0;
+    uint64_t entries = 0;
+
+    while (!reader.eof()) {
+        int tag = 0;
+        reader.byte(tag);
+
+        bool ok = true;
+        switch (tag) {
+            case 'H': {
+                // every writer session starts over: call sites and time base
+                std::string magic;
+                int version = 0;
+                ok = reader.bytes(magic, 4) && magic == "TLOG" && reader.byte(version) && version == 1;
+                sites.clear();
+                time = 0;
+                break;
+            }
+
+            case 'T': {
+                int level = 0;
+                std::string logger, text;
+                ok = reader.byte(level) && reader.time(time) && reader.string(logger) && reader.string(text);
+                if (ok) print(time, level, logger, text);
+                break;
+            }
+
+            case 'D': {
+                uint64_t id = 0;
+                Site site;
+                ok = reader.varint(id) && reader.byte(site.level) && reader.string(site.logger)
+                     && reader.string(site.file) && reader.varint(site.line) && reader.string(site.fmt);
+                if (ok) sites[id] = site;
+                break;
+            }
+
+            case 'R': {
+                uint64_t id = 0, size = 0;
+                std::string payload;
+                ok = reader.varint(id) && reader.time(time) && reader.varint(size) && reader.bytes(payload, size);
+                if (!ok) break;
+
+                std::map<uint64_t, Site>::const_iterator it = sites.find(id);
+                if (it == sites.end()) {
+                    print(time, SIMPLE_LOGGER_WARN, "tinylog_decode", "record of an undefined call site");
+                    break;
+                }
+
+                const Site &site = it->second;
+                print(time, site.level, site.logger,
+                      SimpleLogger::format(site.fmt.c_str(), payload.data(), payload.size()),
+                      verbose ? &site : nullptr);
+                break;
+            }
+
+            default:
+                ok = false;
+                break;
+        }
+
+        if (!ok) {
+            std::cerr << "Corrupted log after " << entries << " entries" << std::endl;
+            return 2;
+        }
+        entries++;
+    }
+
+    return 0;
+}
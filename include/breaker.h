@@ -0,0 +1,160 @@
+#ifndef TINYWORLD_BREAKER_H
+#define TINYWORLD_BREAKER_H
+
+#include <mutex>
+#include <chrono>
+
+//
+// Circuit breaker of a backend (e.g. one MySQL host)
+//
+//   closed    - requests go through, consecutive failures are counted
+//   open      - after `threshold` consecutive failures, requests fail
+//               fast for `open_ms`
+//   half-open - then one probe request at a time goes through, its
+//               success closes the breaker, its failure opens it again
+//
+//   if (!breaker.allow()) return false;     // fail fast
+//   bool ok = query();
+//   ok ? breaker.success() : breaker.failure();
+//
+// Every allow() must be followed by success() or failure(), otherwise a
+// half-open breaker keeps its probe and never lets a request through
+// again. Guard records a failure when its scope is left (or unwound by an
+// exception) with no outcome:
+//
+//   if (!breaker.allow()) return false;
+//   CircuitBreaker::Guard guard(breaker);
+//   query() ? guard.success() : guard.failure();
+//
+class CircuitBreaker {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    class Guard {
+    public:
+        explicit Guard(CircuitBreaker &breaker) : breaker_(breaker) {}
+
+        ~Guard() {
+            if (!done_) breaker_.failure();
+        }
+
+        Guard(const Guard &) = delete;
+
+        Guard &operator=(const Guard &) = delete;
+
+        void success() {
+            done_ = true;
+            breaker_.success();
+        }
+
+        void failure() {
+            done_ = true;
+            breaker_.failure();
+        }
+
+    private:
+        CircuitBreaker &breaker_;
+        bool done_ = false;
+    };
+
+    enum State {
+        kState_Closed,
+        kState_Open,
+        kState_HalfOpen,
+    };
+
+    CircuitBreaker(unsigned int threshold = 5, unsigned int open_ms = 1000)
+            : threshold_(threshold), open_ms_(open_ms) {}
+
+    // 0 disables the breaker
+    void setThreshold(unsigned int failures) { threshold_ = failures; }
+
+    void setOpenTime(unsigned int ms) { open_ms_ = ms; }
+
+    bool allow() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!threshold_) return true;
+
+        switch (state_) {
+            case kState_Closed:
+                return true;
+
+            case kState_Open:
+                if (Clock::now() - opened_ < std::chrono::milliseconds(open_ms_))
+                    return false;
+                state_ = kState_HalfOpen;
+                probing_ = true;
+                return true;
+
+            case kState_HalfOpen:
+                if (probing_)
+                    return false;
+                probing_ = true;
+                return true;
+        }
+
+        return true;
+    }
+
+    // allow() would let a request through, without taking the probe
+    bool available() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!threshold_) return true;
+
+        switch (state_) {
+            case kState_Closed   : return true;
+            case kState_Open     : return Clock::now() - opened_ >= std::chrono::milliseconds(open_ms_);
+            case kState_HalfOpen : return !probing_;
+        }
+
+        return true;
+    }
+
+    void success() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        failures_ = 0;
+        probing_ = false;
+        state_ = kState_Closed;
+    }
+
+    void failure() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        probing_ = false;
+        if (state_ == kState_HalfOpen || ++failures_ >= threshold_) {
+            if (threshold_) open();
+        }
+    }
+
+    State state() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return state_;
+    }
+
+    // times the breaker has opened
+    unsigned long opens() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return opens_;
+    }
+
+protected:
+    // mutex_ held
+    void open() {
+        state_ = kState_Open;
+        opened_ = Clock::now();
+        failures_ = 0;
+        opens_++;
+    }
+
+private:
+    std::mutex mutex_;
+    unsigned int threshold_;
+    unsigned int open_ms_;
+
+    State state_ = kState_Closed;
+    unsigned int failures_ = 0;
+    bool probing_ = false;
+    Clock::time_point opened_;
+    unsigned long opens_ = 0;
+};
+
+#endif //TINYWORLD_BREAKER_H
@@ -0,0 +1,87 @@
+#ifndef TINYWORLD_GATHER_H
+#define TINYWORLD_GATHER_H
+
+#include <cctype>
+#include <string>
+#include <vector>
+#include <memory>
+#include <queue>
+#include <functional>
+
+//
+// The gather side of the scatter-gather queries (TinyMySqlShardingORM::
+// loadFromAllShards): merging the shards' results, no MySQL here.
+//
+
+//
+// k-way merge of the parts, each sorted by less, appended to records,
+// up to limit records in all (0: no limit)
+//
+template<typename T>
+inline void gather_merge_sorted(std::vector<std::vector<std::shared_ptr<T>>> &parts,
+                                const std::function<bool(const T &, const T &)> &less,
+                                size_t limit, std::vector<std::shared_ptr<T>> &records) {
+    // (part, position), the heap's top is the smallest head
+    typedef std::pair<size_t, size_t> Head;
+    auto greater = [&parts, &less](const Head &a, const Head &b) {
+        return less(*parts[b.first][b.second], *parts[a.first][a.second]);
+    };
+    std::priority_queue<Head, std::vector<Head>, decltype(greater)> heads(greater);
+
+    size_t total = 0;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        total += parts[i].size();
+        if (!parts[i].empty())
+            heads.push(Head(i, 0));
+    }
+
+    records.reserve(records.size() + (limit && limit < total ? limit : total));
+    while (!heads.empty() && (!limit || records.size() < limit)) {
+        Head head = heads.top();
+        heads.pop();
+
+        records.push_back(parts[head.first][head.second]);
+        if (++head.second < parts[head.first].size())
+            heads.push(head);
+    }
+}
+
+inline bool gather_word_char(char c) {
+    return isalnum((unsigned char) c) || c == '_';
+}
+
+//
+// the clause has a LIMIT of its own: the keyword as a word, outside of
+// quotes and parentheses (a subquery's LIMIT does not count)
+//
+inline bool gather_has_limit(const std::string &clause) {
+    static const char keyword[] = "LIMIT";
+    const size_t length = sizeof(keyword) - 1;
+
+    char quote = 0;
+    int depth = 0;
+    for (size_t i = 0; i < clause.size(); ++i) {
+        char c = clause[i];
+        if (quote) {
+            if (c == '\\' && quote != '`')
+                ++i;
+            else if (c == quote)
+                quote = 0;
+        } else if (c == '\'' || c == '"' || c == '`') {
+            quote = c;
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')') {
+            if (depth) depth--;
+        } else if (!depth && i + length <= clause.size() && (!i || !gather_word_char(clause[i - 1]))) {
+            size_t n = 0;
+            while (n < length && toupper((unsigned char) clause[i + n]) == keyword[n])
+                n++;
+            if (n == length && (i + length == clause.size() || !gather_word_char(clause[i + length])))
+                return true;
+        }
+    }
+    return false;
+}
+
+#endif //TINYWORLD_GATHER_H
@@ -27,4 +27,46 @@ inline uint32_t hash_murmur(const std::string& key)
 	return hash_murmur(key.c_str(), key.size());
 }
 
+//
+// 64-bit and wider hashes, same results on every platform (little-endian
+// definition, unaligned input is fine):
+//
+//   hash_xxh64       - xxHash64, fastest on long keys
+//   hash_murmur3_128 - MurmurHash3_x64_128, out[0] alone is a good 64-bit hash
+//   hash_crc32c      - CRC32C (Castagnoli), the SSE4.2 instruction when the
+//                      CPU has it. Incremental: pass the previous result as crc
+//
+uint64_t hash_xxh64(const char *key, size_t length, uint64_t seed = 0);
+
+inline uint64_t hash_xxh64(const std::string& key)
+{
+	return hash_xxh64(key.data(), key.size());
+}
+
+void hash_murmur3_128(const char *key, size_t length, uint32_t seed, uint64_t out[2]);
+
+inline uint64_t hash_murmur3_64(const std::string& key)
+{
+	uint64_t out[2];
+	hash_murmur3_128(key.data(), key.size(), 0, out);
+	return out[0];
+}
+
+uint32_t hash_crc32c(const char *key, size_t length, uint32_t crc = 0);
+
+// table-driven, for comparing with the SSE4.2 path
+uint32_t hash_crc32c_soft(const char *key, size_t length, uint32_t crc = 0);
+
+inline uint32_t hash_crc32c(const std::string& key)
+{
+	return hash_crc32c(key.data(), key.size());
+}
+
+//
+// Jump Consistent Hash (Lamping & Veach)
+// maps key to a bucket in [0, buckets), growing buckets from N to N+1
+// only moves 1/(N+1) of the keys.
+//
+int32_t jump_consistent_hash(uint64_t key, int32_t buckets);
+
 #endif // __COMMON_HASHKIT_H
@@ -0,0 +1,165 @@
+#ifndef TINYWORLD_LATENCY_H
+#define TINYWORLD_LATENCY_H
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+
+//
+// Latency percentiles over the last one or two windows (default 10s),
+// lock-free. Samples (us) go to log-scale buckets, 4 sub-buckets per
+// power of 2, so a percentile is accurate within 25%.
+//
+//   tracker.record(elapsed_us);
+//   uint64_t p95 = tracker.percentile(95);
+//
+// Samples recorded while a window is being recycled may be lost.
+//
+class LatencyTracker {
+public:
+    enum { kBuckets = 256 };
+
+    explicit LatencyTracker(unsigned int window = 10) : window_(window ? window : 1) {
+        for (int i = 0; i < 2; ++i)
+            reset(windows_[i], -1);
+    }
+
+    void record(uint64_t us) {
+        Window &w = current();
+        w.counts[bucket(us)]++;
+        w.count++;
+        w.sum += us;
+    }
+
+    //
+    // p in [0, 100], the upper bound of the bucket, 0 if no sample
+    //
+    uint64_t percentile(double p) {
+        uint64_t counts[kBuckets] = {0};
+        uint64_t total = 0;
+
+        int64_t epoch = now();
+        for (int i = 0; i < 2; ++i) {
+            Window &w = windows_[i];
+            int64_t e = w.epoch;
+            if (e != epoch && e != epoch - 1) continue;
+
+            for (size_t b = 0; b < kBuckets; ++b) {
+                counts[b] += w.counts[b];
+                total += w.counts[b];
+            }
+        }
+
+        if (!total) return 0;
+
+        uint64_t rank = (uint64_t) (total * p / 100.0);
+        if (rank >= total) rank = total - 1;
+
+        uint64_t seen = 0;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            seen += counts[b];
+            if (seen > rank)
+                return upper(b);
+        }
+
+        return upper(kBuckets - 1);
+    }
+
+    uint64_t count() {
+        uint64_t total = 0;
+        int64_t epoch = now();
+        for (int i = 0; i < 2; ++i) {
+            int64_t e = windows_[i].epoch;
+            if (e == epoch || e == epoch - 1)
+                total += windows_[i].count;
+        }
+        return total;
+    }
+
+    uint64_t mean() {
+        uint64_t total = 0, sum = 0;
+        int64_t epoch = now();
+        for (int i = 0; i < 2; ++i) {
+            int64_t e = windows_[i].epoch;
+            if (e == epoch || e == epoch - 1) {
+                total += windows_[i].count;
+                sum += windows_[i].sum;
+            }
+        }
+        return total ? sum / total : 0;
+    }
+
+    //
+    // samples per second over the previous and the current (partial) window
+    //
+    double rate() {
+        int64_t ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t epoch = ms / 1000 / window_;
+
+        uint64_t total = 0;
+        double elapsed = (ms - epoch * window_ * 1000) / 1000.0;
+        for (int i = 0; i < 2; ++i) {
+            int64_t e = windows_[i].epoch;
+            if (e == epoch) {
+                total += windows_[i].count;
+            } else if (e == epoch - 1) {
+                total += windows_[i].count;
+                elapsed += window_;
+            }
+        }
+        return elapsed > 0 ? total / elapsed : 0;
+    }
+
+    static size_t bucket(uint64_t us) {
+        if (us < 8) return (size_t) us;
+
+        int msb = 63 - __builtin_clzll(us);
+        return 8 + (msb - 3) * 4 + ((us >> (msb - 2)) & 3);
+    }
+
+    static uint64_t upper(size_t bucket) {
+        if (bucket < 8) return bucket;
+
+        int msb = (int) (bucket - 8) / 4 + 3;
+        uint64_t sub = (bucket - 8) % 4;
+        return ((4 + sub + 1) << (msb - 2)) - 1;
+    }
+
+protected:
+    struct Window {
+        std::atomic<int64_t> epoch;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> counts[kBuckets];
+    };
+
+    int64_t now() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count() / window_;
+    }
+
+    Window &current() {
+        int64_t epoch = now();
+        Window &w = windows_[epoch & 1];
+
+        int64_t old = w.epoch;
+        if (old != epoch && w.epoch.compare_exchange_strong(old, epoch))
+            reset(w, epoch);
+        return w;
+    }
+
+    static void reset(Window &w, int64_t epoch) {
+        for (size_t b = 0; b < kBuckets; ++b)
+            w.counts[b] = 0;
+        w.count = 0;
+        w.sum = 0;
+        w.epoch = epoch;
+    }
+
+private:
+    unsigned int window_;
+    Window windows_[2];
+};
+
+#endif //TINYWORLD_LATENCY_H
@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <chrono>
 #include <thread>
+#include <condition_variable>
+#include <vector>
+#include "tinylogger.h"
 
 ////////////////////////////////////////////////////////////////
 //
@@ -194,6 +197,73 @@ private:
     std::mutex mutex_;
 };
 
+////////////////////////////////////////////////////////////////
+//
+// 连接池优先级
+//
+//  - High  : latency-critical work, may use the reserved connections
+//  - Normal: default
+//  - Low   : background work (full-table loads, periodic saves...)
+//
+//  Waiters are served in priority order.
+//
+////////////////////////////////////////////////////////////////
+enum PoolPriority {
+    kPoolPriority_High,
+    kPoolPriority_Normal,
+    kPoolPriority_Low,
+    kPoolPriority_Max,
+};
+
+////////////////////////////////////////////////////////////////
+//
+// 连接池自适应策略
+//
+//  - grow  : average acquire wait time or utilization is above the
+//            thresholds, add `step` connections to the target.
+//  - shrink: utilization stays below `shrink_utilization` for
+//            `shrink_idletime` seconds, remove `step` connections.
+//
+//  The gap between the grow/shrink thresholds plus `cooldown` is the
+//  hysteresis that keeps the target from flapping.
+//
+////////////////////////////////////////////////////////////////
+struct PoolAdaptivePolicy {
+    bool enabled = false;
+
+    // target is always kept in [min_conns, max_conns]
+    unsigned int min_conns = 1;
+    unsigned int max_conns = 1;
+
+    // grow if the average acquire wait time exceeds this (ms)
+    unsigned int grow_waittime = 5;
+    // grow if in-use / target exceeds this (percent)
+    unsigned int grow_utilization = 90;
+
+    // shrink if in-use / target stays below this (percent) ...
+    unsigned int shrink_utilization = 30;
+    // ... for this long (seconds)
+    unsigned int shrink_idletime = 60;
+
+    // minimum seconds between two adjustments
+    unsigned int cooldown = 5;
+    // connections added/removed per adjustment
+    unsigned int step = 1;
+};
+
+//
+// Snapshot of the pool for monitoring
+//
+struct PoolStats {
+    unsigned int target = 0;        // current connection limit
+    unsigned int connections = 0;   // connections open, idle ones included
+    unsigned int in_use = 0;        // connections being used
+    unsigned int peak_in_use = 0;   // peak in-use since last adjustment
+    unsigned int avg_waittime = 0;  // average acquire wait time (us)
+    unsigned long grows = 0;        // times the target grew
+    unsigned long shrinks = 0;      // times the target shrank
+};
+
 ////////////////////////////////////////////////////////////////
 //
 // 连接池封装（有上限）
@@ -203,11 +273,22 @@ template<typename Connection, typename PoolType = ConnectionPool<Connection> >
 class ConnectionPoolWithLimit : public PoolType {
 public:
     typedef PoolType Base;
+    typedef std::chrono::steady_clock Clock;
 
     ConnectionPoolWithLimit(const unsigned int maxconn = 1) {
         conns_max_ = maxconn;
         conns_in_use_ = 0;
         grab_waittime_ = -1;
+        high_reserved_ = 0;
+        for (int i = 0; i < kPoolPriority_Max; ++i)
+            waiting_[i] = 0;
+        peak_in_use_ = 0;
+        avg_waittime_ = 0;
+        grows_ = 0;
+        shrinks_ = 0;
+        shrink_pending_ = false;
+        last_adjust_ = Clock::now();
+        last_busy_ = Clock::now();
     }
 
     virtual ~ConnectionPoolWithLimit() {
@@ -217,8 +298,16 @@ public:
     //
     // aquire the resource
     //
-    Connection *acquire() {
-        return this->grab();
+    Connection *acquire(PoolPriority priority = kPoolPriority_Normal) {
+        return this->grab(priority);
+    }
+
+    //
+    // no waiting whatever the grab wait time, NULL if none is free
+    // (background checks that must not stall)
+    //
+    Connection *tryAcquire(PoolPriority priority = kPoolPriority_Normal) {
+        return grabWithin(priority, 0);
     }
 
     //
@@ -236,6 +325,58 @@ public:
         conns_max_ = maxconn;
     }
 
+    unsigned int maxConn() const { return conns_max_; }
+
+    //
+    // adaptive pool sizing, the target starts at policy.min_conns
+    //
+    void setAdaptivePolicy(const PoolAdaptivePolicy &policy) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        policy_ = policy;
+        if (policy_.min_conns < 1)
+            policy_.min_conns = 1;
+        if (policy_.max_conns < policy_.min_conns)
+            policy_.max_conns = policy_.min_conns;
+        if (policy_.step < 1)
+            policy_.step = 1;
+
+        if (policy_.enabled)
+            conns_max_ = policy_.min_conns;
+
+        last_adjust_ = Clock::now();
+        last_busy_ = last_adjust_;
+        peak_in_use_ = 0;
+    }
+
+    const PoolAdaptivePolicy &adaptivePolicy() const { return policy_; }
+
+    PoolStats stats() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        PoolStats st;
+        st.target = conns_max_;
+        st.connections = (unsigned int) Base::size();
+        st.in_use = conns_in_use_;
+        st.peak_in_use = peak_in_use_;
+        st.avg_waittime = avg_waittime_;
+        st.grows = grows_;
+        st.shrinks = shrinks_;
+        return st;
+    }
+
+    //
+    // Re-evaluate the adaptive target without a grab/release: a pool
+    // without traffic only shrinks when this is called periodically
+    // (MySqlConnectionPool is ticked by MySqlPoolMaintainer)
+    //
+    void adjust() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        unsigned int target = conns_max_;
+        adapt();
+        trim();
+        if (conns_max_ > target)
+            wakeupAll();
+    }
+
     //
     // -1 - waiting for resource forever(your first choice)
     // N  - waiting for resource with timeout(ms)
@@ -245,6 +386,14 @@ public:
         grab_waittime_ = ms;
     }
 
+    //
+    // percent of connections only kPoolPriority_High can use
+    //
+    void setHighReserved(unsigned int percent) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        high_reserved_ = std::min(percent, 100u);
+    }
+
     //
     // create all the resource (using this at starting point)
     // once created, will not going to release it, you can aquire it
@@ -252,7 +401,7 @@ public:
     void createAll() {
         std::vector<Connection *> conns;
         for (unsigned int i = 0; i < conns_max_; i++)
-            conns.push_back(acquire());
+            conns.push_back(acquire(kPoolPriority_High));
 
         for (size_t i = 0; i < conns.size(); i++)
             putback(conns[i]);
@@ -260,62 +409,186 @@ public:
 
 public:
     virtual Connection *grab() {
-        // no wait
-        if (grab_waittime_ == 0) {
-            if (conns_in_use_ >= conns_max_) {
-                std::cout << "grab failed: not engouh" << std::endl;
-                return NULL;
-            }
-        }
+        return grab(kPoolPriority_Normal);
+    }
+
+    // acquire() comes here: subclasses override this one, grab() forwards to it
+    virtual Connection *grab(PoolPriority priority) {
+        return grabWithin(priority, grab_waittime_);
+    }
+
+    virtual void release(const Connection *pc) {
+        Base::release(pc);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        --conns_in_use_;
+        adapt();
+        trim();
+        wakeup();
+    }
+
+    virtual Connection *create() = 0;
+
+    virtual void destroy(Connection *cp) {
+        delete cp;
+    }
+
+protected:
+    // waittime: as setGrabWaitTime()
+    Connection *grabWithin(PoolPriority priority, int waittime) {
+        Clock::time_point start = Clock::now();
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            auto ready = [this, priority]() { return canGrab(priority); };
+
+            ++waiting_[priority];
+            bool ok = true;
+            // no wait
+            if (waittime == 0)
+                ok = ready();
             // waiting for release forever
-        else if (grab_waittime_ < 0) {
-            while (conns_in_use_ >= conns_max_) {
-                std::chrono::milliseconds ms(1);
-                std::this_thread::sleep_for(ms);
-            }
-        }
-            // wating for release during grab_waittime_(ms)
-        else if (grab_waittime_ > 0) {
-            int tries = 0;
-            while (conns_in_use_ >= conns_max_) {
-                // waiting for release
-                std::chrono::milliseconds ms(grab_waittime_);
-                std::this_thread::sleep_for(ms);
-
-                if (++tries > 1000)
-                    return NULL;
+            else if (waittime < 0)
+                cond_[priority].wait(lock, ready);
+            // wating for release during waittime(ms)
+            else
+                ok = cond_[priority].wait_for(lock, std::chrono::milliseconds(waittime), ready);
+            --waiting_[priority];
+
+            if (!ok) {
+                // pass the turn to the lower priority waiters
+                wakeup();
+
+                // logged unlocked, the log may be synchronous
+                unsigned int target = conns_max_, in_use = conns_in_use_;
+                lock.unlock();
+                LOG_WARN("pool", "grab failed: not enough connections (target=%u in use=%u)", target, in_use);
+                return NULL;
             }
-        }
 
-        {
-            std::lock_guard<std::mutex> guard(mutex_);
             ++conns_in_use_;
+            wakeup();
+
+            unsigned int waited = std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - start).count();
+            avg_waittime_ = avg_waittime_ - avg_waittime_ / 8 + waited / 8;
+
+            unsigned int target = conns_max_;
+            adapt();
+            if (conns_max_ > target)
+                wakeupAll();
         }
 
         return Base::grab();
     }
 
-    virtual void release(const Connection *pc) {
-        Base::release(pc);
+    //
+    // mutex_ held: a connection is free for this priority and no one
+    // with higher priority is waiting
+    //
+    bool canGrab(PoolPriority priority) {
+        for (int i = 0; i < priority; ++i)
+            if (waiting_[i] > 0)
+                return false;
 
-        {
-            std::lock_guard<std::mutex> guard(mutex_);
-            --conns_in_use_;
+        unsigned int limit = conns_max_;
+        if (priority != kPoolPriority_High)
+            limit -= std::min(conns_max_ * high_reserved_ / 100, conns_max_ - 1);
+
+        return conns_in_use_ < limit;
+    }
+
+    //
+    // mutex_ held: wake up one waiter of the highest waiting priority
+    //
+    void wakeup() {
+        for (int i = 0; i < kPoolPriority_Max; ++i) {
+            if (waiting_[i] > 0) {
+                cond_[i].notify_one();
+                return;
+            }
         }
     }
 
-    virtual Connection *create() = 0;
+    void wakeupAll() {
+        for (int i = 0; i < kPoolPriority_Max; ++i)
+            cond_[i].notify_all();
+    }
 
-    virtual void destroy(Connection *cp) {
-        delete cp;
+    //
+    // Re-evaluate the target (mutex_ held). When the target shrinks the
+    // idle connections above it are dropped by trim().
+    //
+    void adapt() {
+        if (!policy_.enabled)
+            return;
+
+        Clock::time_point now = Clock::now();
+        if (conns_in_use_ > peak_in_use_)
+            peak_in_use_ = conns_in_use_;
+        if (conns_in_use_ * 100 >= conns_max_ * policy_.shrink_utilization)
+            last_busy_ = now;
+
+        if (now - last_adjust_ < std::chrono::seconds(policy_.cooldown))
+            return;
+
+        if ((avg_waittime_ >= policy_.grow_waittime * 1000
+             || peak_in_use_ * 100 >= conns_max_ * policy_.grow_utilization)
+            && conns_max_ < policy_.max_conns) {
+            conns_max_ = std::min(conns_max_ + policy_.step, policy_.max_conns);
+            ++grows_;
+        } else if (now - last_busy_ >= std::chrono::seconds(policy_.shrink_idletime)
+                   && conns_max_ > policy_.min_conns) {
+            conns_max_ = std::max(conns_max_ - std::min(policy_.step, conns_max_), policy_.min_conns);
+            ++shrinks_;
+            last_busy_ = now;
+            shrink_pending_ = true;
+        } else {
+            return;
+        }
+
+        last_adjust_ = now;
+        peak_in_use_ = conns_in_use_;
+    }
+
+    //
+    // mutex_ held: after a shrink, destroy idle connections until no more
+    // than the target are open. The ones in use stay, so are the grabs
+    // already counted in conns_in_use_ (they take an idle one next).
+    //
+    void trim() {
+        if (!shrink_pending_)
+            return;
+        shrink_pending_ = false;
+
+        size_t open = Base::size();
+        size_t idle = open > conns_in_use_ ? open - conns_in_use_ : 0;
+        size_t excess = open > conns_max_ ? open - conns_max_ : 0;
+        for (size_t n = std::min(idle, excess); n > 0; --n)
+            Base::remove(Base::grab());
     }
 
-protected:
     // Number of connections currently in use
     volatile unsigned int conns_in_use_;
     unsigned int conns_max_;
     int grab_waittime_;
     std::mutex mutex_;
+
+    // Priority lanes
+    unsigned int high_reserved_;
+    unsigned int waiting_[kPoolPriority_Max];
+    std::condition_variable cond_[kPoolPriority_Max];
+
+    // Adaptive sizing
+    PoolAdaptivePolicy policy_;
+    unsigned int peak_in_use_;
+    unsigned int avg_waittime_;
+    unsigned long grows_;
+    unsigned long shrinks_;
+    bool shrink_pending_;
+    Clock::time_point last_adjust_;
+    Clock::time_point last_busy_;
 };
 
 template<typename ConnType, typename PoolType>
@@ -324,6 +597,9 @@ public:
     explicit ScopedConnection(PoolType *pool = &PoolType::instance())
             : pool_(pool), connection_(pool ? (ConnType *) pool->acquire() : NULL) {}
 
+    explicit ScopedConnection(PoolPriority priority, PoolType *pool = &PoolType::instance())
+            : pool_(pool), connection_(pool ? (ConnType *) pool->acquire(priority) : NULL) {}
+
     ~ScopedConnection() {
         if (pool_) pool_->putback(connection_);
     }
@@ -1,7 +1,9 @@
 #ifndef TINYWORLD_POOL_SHARDING_H
 #define TINYWORLD_POOL_SHARDING_H
 
+#include "pool.h"
 #include "sharding.h"
+#include "shardstats.h"
 
 template<typename ConnType, typename PoolType>
 class ShardingConnectionPool : public Sharding<PoolType> {
@@ -15,28 +17,49 @@ public:
     virtual ~ShardingConnectionPool() {}
 
 public:
-    ConnType *acquireByShard(int shard) {
+    ConnType *acquireByShard(int shard, PoolPriority priority = kPoolPriority_Normal) {
         PoolType *pool = this->getShardByID(shard);
         if (pool) {
-            return (ConnType *) pool->acquire();
+            return (ConnType *) pool->acquire(priority);
         }
 
         return NULL;
     }
 
-    ConnType *acquireByHash(uint32_t hash) {
+    //
+    // read-only work: PoolType::acquireRead() may pick one of the shard's replicas
+    //
+    ConnType *acquireReadByShard(int shard, PoolPriority priority = kPoolPriority_Normal) {
+        PoolType *pool = this->getShardByID(shard);
+        if (pool) {
+            return (ConnType *) pool->acquireRead(priority);
+        }
+
+        return NULL;
+    }
+
+    ConnType *acquireByHash(uint32_t hash, PoolPriority priority = kPoolPriority_Normal) {
         PoolType *pool = this->getShardByHash(hash);
         if (pool) {
-            return (ConnType *) pool->acquire();
+            return (ConnType *) pool->acquire(priority);
         }
 
         return NULL;
     }
 
-    ConnType *acquireByKey(const std::string &key) {
+    ConnType *acquireByKey(const std::string &key, PoolPriority priority = kPoolPriority_Normal) {
         PoolType *pool = this->getShardByKey(key);
         if (pool) {
-            return (ConnType *) pool->acquire();
+            return (ConnType *) pool->acquire(priority);
+        }
+
+        return NULL;
+    }
+
+    ConnType *acquireByEmbeddedID(uint64_t id, PoolPriority priority = kPoolPriority_Normal) {
+        PoolType *pool = this->getShardByEmbeddedID(id);
+        if (pool) {
+            return (ConnType *) pool->acquire(priority);
         }
 
         return NULL;
@@ -50,14 +73,23 @@ public:
             return pool->putback(conn);
         }
     }
+
+    //
+    // per-shard QPS/latency and hot keys, fed by the sharded ORM
+    //
+    ShardingStats &stats() { return stats_; }
+
+private:
+    ShardingStats stats_;
 };
 
 
 template<typename ConnType, typename PoolType>
 class ScopedConnectionByShard {
 public:
-    explicit ScopedConnectionByShard(int shard, PoolType *pool = PoolType::instance())
-            : pool_(pool), connection_(pool->acquireByShard(shard)) {}
+    explicit ScopedConnectionByShard(int shard, PoolType *pool = PoolType::instance(),
+                                     PoolPriority priority = kPoolPriority_Normal)
+            : pool_(pool), connection_(pool->acquireByShard(shard, priority)) {}
 
     ~ScopedConnectionByShard() {
         if (pool_) pool_->putback(connection_);
@@ -74,6 +106,28 @@ private:
     ConnType *connection_;
 };
 
+template<typename ConnType, typename PoolType>
+class ScopedReadConnectionByShard {
+public:
+    explicit ScopedReadConnectionByShard(int shard, PoolType *pool = PoolType::instance(),
+                                         PoolPriority priority = kPoolPriority_Normal)
+            : pool_(pool), connection_(pool->acquireReadByShard(shard, priority)) {}
+
+    ~ScopedReadConnectionByShard() {
+        if (pool_) pool_->putback(connection_);
+    }
+
+    ConnType *operator->() const { return connection_; }
+
+    ConnType &operator*() const { return *connection_; }
+
+    operator void *() const { return connection_; }
+
+private:
+    PoolType *pool_;
+    ConnType *connection_;
+};
+
 template<typename ConnType, typename PoolType>
 class ScopedConnectionByHash {
 public:
@@ -0,0 +1,134 @@
+#ifndef TINYWORLD_SHARDBATCH_H
+#define TINYWORLD_SHARDBATCH_H
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+//
+// The statements of a batch write over shards (TinyMySqlShardingORM::
+// writeBatch), no MySQL here:
+//
+//   ShardBatch<Player> batch;
+//   for (auto obj : objs)
+//       batch.add(obj, ids, count);       // owner, and the new owner while migrating
+//   batch.build(replace, 500);            // multi-row statements of up to 500 rows
+//
+//   for (attempt...)                      // every shard in its own thread
+//       rows = batch.run(shard, write);   // the statements not written yet, in order
+//
+// The owners' statements can be run first (kPhase_Primary), then the new
+// owners' (kPhase_Dual): a row is never on its new owner before its owner,
+// as with the single writes.
+//
+// After build() the statements are only read, and every shard's written
+// flags are touched by run() of that shard only: run() of different shards
+// may go concurrently.
+//
+template<typename T>
+class ShardBatch {
+public:
+    struct Statement {
+        bool replace;
+        bool primary;   // to the owner, false: dual-write to the new owner
+        std::vector<const T *> rows;
+    };
+
+    typedef std::function<bool(const Statement &)> Writer;
+
+    enum Phase {
+        kPhase_All,
+        kPhase_Primary,     // to the owners
+        kPhase_Dual,        // to the new owners
+    };
+
+    // ids[0] the owner, ids[1] the new owner (count 2) while migrating
+    void add(const T *row, const int ids[2], int count) {
+        for (int i = 0; i < count && i < 2; ++i)
+            partitions_[i][ids[i]].push_back(row);
+    }
+
+    // the new owner always gets a REPLACE, same as the single writes
+    void build(bool replace, size_t batch_rows) {
+        if (!batch_rows) batch_rows = 1;
+
+        for (int i = 0; i < 2; ++i) {
+            for (auto &partition : partitions_[i]) {
+                auto &rows = partition.second;
+                for (size_t offset = 0; offset < rows.size(); offset += batch_rows) {
+                    Statement statement;
+                    statement.replace = (i == 0 ? replace : true);
+                    statement.primary = (i == 0);
+                    statement.rows.assign(rows.begin() + offset,
+                                          rows.begin() + std::min(offset + batch_rows, rows.size()));
+                    statements_[partition.first].push_back(std::move(statement));
+                }
+            }
+            partitions_[i].clear();
+        }
+
+        for (auto &it : statements_)
+            written_[it.first].resize(it.second.size(), 0);
+    }
+
+    // the shards with statements of the phase not written yet
+    std::vector<int> pending(Phase phase = kPhase_All) const {
+        std::vector<int> shards;
+        for (auto &it : written_) {
+            const std::vector<Statement> &list = statements_.at(it.first);
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (!it.second[i] && inPhase(list[i], phase)) {
+                    shards.push_back(it.first);
+                    break;
+                }
+            }
+        }
+        return shards;
+    }
+
+    //
+    // writes the shard's statements of the phase not written yet in order,
+    // a failed one stays pending for the next run. Returns the rows written,
+    // ok: all of them written
+    //
+    size_t run(int shard, const Writer &write, bool &ok, Phase phase = kPhase_All) {
+        ok = true;
+        auto it = statements_.find(shard);
+        if (it == statements_.end())
+            return 0;
+
+        auto &list = it->second;
+        auto &flags = written_.at(shard);
+        size_t rows = 0;
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (flags[i] || !inPhase(list[i], phase)) continue;
+
+            if (write(list[i])) {
+                flags[i] = 1;
+                rows += list[i].rows.size();
+            } else {
+                ok = false;
+            }
+        }
+        return rows;
+    }
+
+    const std::map<int, std::vector<Statement>> &statements() const { return statements_; }
+
+    bool written(int shard, size_t statement) const {
+        auto it = written_.find(shard);
+        return it != written_.end() && statement < it->second.size() && it->second[statement];
+    }
+
+private:
+    static bool inPhase(const Statement &statement, Phase phase) {
+        return phase == kPhase_All || statement.primary == (phase == kPhase_Primary);
+    }
+
+    std::map<int, std::vector<const T *>> partitions_[2];
+    std::map<int, std::vector<Statement>> statements_;
+    std::map<int, std::vector<int>> written_;
+};
+
+#endif //TINYWORLD_SHARDBATCH_H
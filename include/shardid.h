@@ -0,0 +1,111 @@
+#ifndef TINYWORLD_SHARDID_H
+#define TINYWORLD_SHARDID_H
+
+#include <stdint.h>
+#include <mutex>
+#include <chrono>
+#include <thread>
+
+//
+// 64-bit IDs with the shard embedded in the low bits, so the owner of a
+// record is decoded from its ID without hashing:
+//
+//   snowflake : | 0 | 41 ms since epoch | 4 worker | 8 sequence | 10 shard |
+//   hi/lo     : | 0 | 53 sequence from the shard's sequence table | 10 shard |
+//
+// A record routed by its embedded shard never moves when resharding.
+//
+struct ShardID {
+    enum {
+        kShardBits = 10,
+        kMaxShards = 1 << kShardBits,
+    };
+
+    static const uint64_t kShardMask = (1ULL << kShardBits) - 1;
+
+    static int shard(uint64_t id) { return (int) (id & kShardMask); }
+
+    static uint64_t sequence(uint64_t id) { return id >> kShardBits; }
+
+    static uint64_t make(uint64_t sequence, int shard) {
+        return (sequence << kShardBits) | ((uint64_t) shard & kShardMask);
+    }
+};
+
+//
+// Snowflake-style generator, no storage at all. Every process (or thread
+// pool) needs its own worker number, up to 256 IDs per millisecond per
+// worker, the generator waits for the next millisecond beyond that.
+//
+//   SnowflakeIDGenerator generator(worker);
+//   uint64_t id = generator.next(shard);
+//
+class SnowflakeIDGenerator {
+public:
+    enum {
+        kSequenceBits = 8,
+        kWorkerBits = 4,
+        kTimestampBits = 41,
+        kMaxWorkers = 1 << kWorkerBits,
+    };
+
+    // 2017-01-01 00:00:00 UTC
+    static const uint64_t kDefaultEpoch = 1483228800000ULL;
+
+    explicit SnowflakeIDGenerator(int worker = 0, uint64_t epoch = kDefaultEpoch)
+            : worker_((uint64_t) worker & (kMaxWorkers - 1)), epoch_(epoch) {}
+
+    uint64_t next(int shard) {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        uint64_t now = milliseconds();
+
+        // clock moved backwards: keep counting in the last millisecond
+        if (now < last_)
+            now = last_;
+
+        if (now == last_) {
+            sequence_ = (sequence_ + 1) & ((1 << kSequenceBits) - 1);
+            if (sequence_ == 0) {
+                while (now <= last_) {
+                    std::this_thread::yield();
+                    now = milliseconds();
+                }
+            }
+        } else {
+            sequence_ = 0;
+        }
+
+        last_ = now;
+
+        uint64_t sequence = ((now - epoch_) << (kWorkerBits + kSequenceBits))
+                            | (worker_ << kSequenceBits)
+                            | sequence_;
+        return ShardID::make(sequence, shard);
+    }
+
+    // ms since the Unix epoch the ID was generated at
+    uint64_t timestamp(uint64_t id) const {
+        return (ShardID::sequence(id) >> (kWorkerBits + kSequenceBits)) + epoch_;
+    }
+
+    int worker(uint64_t id) const {
+        return (int) ((ShardID::sequence(id) >> kSequenceBits) & (kMaxWorkers - 1));
+    }
+
+protected:
+    static uint64_t milliseconds() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    uint64_t worker_;
+    uint64_t epoch_;
+
+    std::mutex mutex_;
+    uint64_t last_ = 0;
+    uint64_t sequence_ = 0;
+};
+
+#endif //TINYWORLD_SHARDID_H
@@ -2,9 +2,16 @@
 #define __COMMON_SHARDING_H
 
 #include <map>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstdio>
 #include "hashkit.h"
+#include "shardid.h"
 
-struct MurmurHash 
+struct MurmurHash
 {
 	static uint32_t hash(const std::string& key)
 	{
@@ -12,61 +19,333 @@ struct MurmurHash
 	}
 };
 
+//
+// Alternatives for the Hash parameter, stable across platforms:
+//
+//   Sharding<MySqlConnectionPool, XXHash64> sharding;
+//
+// The 32-bit hash code is the high half of the 64-bit hash. Changing the
+// hash of a live cluster remaps almost every key.
+//
+struct XXHash64
+{
+	static uint32_t hash(const std::string& key)
+	{
+		return (uint32_t)(hash_xxh64(key) >> 32);
+	}
+};
+
+struct Murmur3Hash
+{
+	static uint32_t hash(const std::string& key)
+	{
+		return (uint32_t)(hash_murmur3_64(key) >> 32);
+	}
+};
+
+struct CRC32CHash
+{
+	static uint32_t hash(const std::string& key)
+	{
+		return hash_crc32c(key);
+	}
+};
+
+//
+// How a hash code is mapped to a shard
+//
+enum ShardingStrategy
+{
+	kSharding_Range,    // 2^32 divided into shardnum_ equal ranges (default)
+	kSharding_Ketama,   // consistent hashing ring with virtual nodes
+	kSharding_Jump,     // jump consistent hash
+};
+
+//
+// Ketama-style consistent hashing ring
+//
+// Every shard owns (vnodes * weight) points on the 2^32 ring, a hash
+// code belongs to the first point clockwise. Points are kept in a flat
+// sorted array, lookup is a binary search.
+//
+template <typename Hash=MurmurHash>
+class HashRing
+{
+public:
+	struct Point
+	{
+		uint32_t hash;
+		int shard;
+
+		bool operator<(const Point& rhs) const
+		{
+			return hash < rhs.hash || (hash == rhs.hash && shard < rhs.shard);
+		}
+	};
+
+	HashRing(uint32_t vnodes = 160) : vnodes_(vnodes)
+	{
+	}
+
+	void setVirtualNodes(uint32_t vnodes) { vnodes_ = vnodes; }
+
+	uint32_t virtualNodes() { return vnodes_; }
+
+	//
+	// shards: 0..shardnum-1, weights[i] defaults to 1
+	//
+	void build(int shardnum, const std::map<int, uint32_t>& weights)
+	{
+		points_.clear();
+		for (int shard = 0; shard < shardnum; shard++)
+		{
+			uint32_t weight = 1;
+			std::map<int, uint32_t>::const_iterator it = weights.find(shard);
+			if (it != weights.end())
+				weight = it->second;
+
+			for (uint32_t i = 0; i < vnodes_ * weight; i++)
+			{
+				char label[64] = "";
+				int len = snprintf(label, sizeof(label), "SHARD-%d-%u", shard, i);
+
+				Point point;
+				point.hash = Hash::hash(std::string(label, len));
+				point.shard = shard;
+				points_.push_back(point);
+			}
+		}
+
+		std::sort(points_.begin(), points_.end());
+	}
+
+	int shardByHash(uint32_t hashcode) const
+	{
+		if (points_.empty()) return -1;
+
+		Point key;
+		key.hash = hashcode;
+		key.shard = -1;
+
+		typename std::vector<Point>::const_iterator it = std::lower_bound(points_.begin(), points_.end(), key);
+		if (it == points_.end())
+			it = points_.begin();
+		return it->shard;
+	}
+
+	size_t size() const { return points_.size(); }
+
+private:
+	uint32_t vnodes_;
+	std::vector<Point> points_;
+};
+
+//
+// Routing of hash codes to shard ids, immutable once published
+//
+template <typename Hash=MurmurHash>
+struct ShardingLayout
+{
+	ShardingLayout(int num = 1) : shardnum(num), strategy(kSharding_Range)
+	{
+		build();
+	}
+
+	void build()
+	{
+		if (strategy == kSharding_Ketama)
+			ring.build(shardnum, weights);
+
+		// kSharding_Range: a shift when shardnum is 2^n, a division otherwise
+		shift = -1;
+		range = shardnum > 0 ? 4294967296ULL / shardnum : 0;
+		if (shardnum > 0 && (shardnum & (shardnum - 1)) == 0)
+			shift = 32 - __builtin_ctz(shardnum);
+	}
+
+	int shardIDByHash(uint32_t hashcode) const
+	{
+		if (shardnum <= 0) return -1;
+
+		switch (strategy)
+		{
+			case kSharding_Ketama : return ring.shardByHash(hashcode);
+			case kSharding_Jump   : return jump_consistent_hash(hashcode, shardnum);
+			default : break;
+		}
+
+		//
+		// MAXINT divided by SHARDNUM
+		//
+		// N: total sharding number(2^x)
+		// M: 2^32
+		//
+		// shard0  shard1   shard2       shard(N-1)
+		// |________|________|............|
+		// 0      M/N       2M/N          M
+		//
+		if (shift >= 0)
+			return (int)((uint64_t)hashcode >> shift);
+
+		// the last range takes the remainder
+		int shard = (int)(hashcode / range);
+		return shard < shardnum ? shard : shardnum - 1;
+	}
+
+	// total shards number(best to be 2^n)
+	int shardnum;
+	ShardingStrategy strategy;
+
+	// precomputed by build()
+	int shift;
+	uint64_t range;
+
+	HashRing<Hash> ring;
+	std::map<int, uint32_t> weights;
+};
+
 template <typename Shard, typename Hash=MurmurHash>
 class Sharding
 {
 public:
-	typedef std::map<int, Shard*> Shards;
+	// indexed by shard id, NULL if not added
+	typedef std::vector<Shard*> Shards;
+	typedef ShardingLayout<Hash> Layout;
+
+	//
+	// Retired layouts and shard tables are never freed (a router may still
+	// read them), so the reconfigurations are capped: set*() and
+	// beginMigration() fail once kMaxLayouts layouts were published, and
+	// addShard() once kMaxTables tables were (clearShards() never fails).
+	// Configure at startup.
+	//
+	enum
+	{
+		kMaxLayouts = 64,
+		kMaxTables = 2 * ShardID::kMaxShards,
+	};
 
-	Sharding(int shardnum = 1) : shardnum_(shardnum) 
+	Sharding(int shardnum = 1)
 	{
+		layout_ = NULL;
+		next_layout_ = NULL;
+		publish(Layout(shardnum));
+
+		tables_.push_back(std::make_shared<Shards>());
+		shards_ = tables_.back().get();
 	}
 
 	~Sharding()
 	{
 	}
 
-	void setShardNum(int shardnum)
+	bool setShardNum(int shardnum)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!reconfigurable()) return false;
+
+		Layout layout = *layout_.load();
+		layout.shardnum = shardnum;
+		publish(layout);
+		return true;
+	}
+
+	int shardNum() { return layout_.load()->shardnum; }
+
+	//
+	// The layout setters fail while migrating (the next layout would not
+	// follow them) or when kMaxLayouts is reached
+	//
+
+	//
+	// kSharding_Range  - changing shardnum remaps almost every key
+	// kSharding_Ketama - adding a shard moves ~1/N keys, supports weights
+	// kSharding_Jump   - adding a shard moves ~1/N keys, no memory
+	//
+	bool setStrategy(ShardingStrategy strategy)
 	{
-		shardnum_ = shardnum;
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!reconfigurable()) return false;
+
+		Layout layout = *layout_.load();
+		layout.strategy = strategy;
+		publish(layout);
+		return true;
 	}
 
-	int shardNum() { return shardnum_; }
+	ShardingStrategy strategy() { return layout_.load()->strategy; }
+
+	//
+	// kSharding_Ketama only : virtual nodes of every shard and shard's weight
+	//
+	bool setVirtualNodes(uint32_t vnodes)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!reconfigurable()) return false;
+
+		Layout layout = *layout_.load();
+		layout.ring.setVirtualNodes(vnodes);
+		publish(layout);
+		return true;
+	}
+
+	bool setShardWeight(int shard, uint32_t weight)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!reconfigurable()) return false;
+
+		Layout layout = *layout_.load();
+		layout.weights[shard] = weight;
+		publish(layout);
+		return true;
+	}
 
 	bool isReady()
 	{
-		for (int i = 0; i < shardnum_; i++)
-			if (shards_.find(i) == shards_.end())
+		int shardnum = shardNum();
+		for (int i = 0; i < shardnum; i++)
+			if (!getShardByID(i))
 				return false;
 		return true;
 	}
 
+	//
+	// shard ids in [0, ShardID::kMaxShards). Safe while other threads
+	// route: the table is copied, the old copy is kept alive.
+	//
 	bool addShard(Shard* shard)
 	{
 		if (!shard) return false;
 
-		if (shard->shard() == -1) return false;
+		int id = shard->shard();
+		if (id < 0 || id >= ShardID::kMaxShards) return false;
 
-		if (shards_.find(shard->shard()) != shards_.end())
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (tables_.size() >= kMaxTables) return false;
+
+		Shards shards = *shards_.load();
+		if ((size_t)id < shards.size() && shards[id])
 			return false;
 
-		shards_[shard->shard()] = shard;
+		if ((size_t)id >= shards.size())
+			shards.resize(id + 1, NULL);
+		shards[id] = shard;
+
+		publishShards(shards);
 		return true;
 	}
 
 	//
-	// MAXINT divided by SHARDNUM
-	//
-	// N: total sharding number(2^x)
-	// M: 2^32
-	// 
-	// shard0  shard1   shard2       shard(N-1)
-	// |________|________|............|
-	// 0      M/N       2M/N          M
+	// hash code -> shard id
 	//
+	int shardIDByHash(uint32_t hashcode)
+	{
+		return layout_.load()->shardIDByHash(hashcode);
+	}
+
 	Shard* getShardByHash(uint32_t hashcode)
 	{
-		return shardnum_ > 0 ? getShardByID(hashcode / (4294967296UL/shardnum_)) : NULL;
+		return getShardByID(shardIDByHash(hashcode));
 	}
 
 	Shard* getShardByKey(const std::string& key)
@@ -74,19 +353,172 @@ public:
 		return getShardByHash(Hash::hash(key));
 	}
 
+	// one bounds check and a load, -1 (unroutable) gives NULL
 	Shard* getShardByID(int shard)
 	{
-		typename Shards::iterator it = shards_.find(shard);
-		if (it != shards_.end())
-			return it->second;
-		return NULL;
+		const Shards* shards = shards_.load(std::memory_order_acquire);
+		return (size_t)shard < shards->size() ? (*shards)[shard] : NULL;
+	}
+
+public:
+	//
+	// Migration window (online resharding)
+	//
+	//   beginMigration(16)  - reads still use the current layout, writes
+	//                         go to the owners in both layouts
+	//   commitMigration()   - switch to the new layout atomically
+	//   abortMigration()    - drop the new layout
+	//
+	// The shards of the new layout must be added before beginMigration().
+	//
+	bool beginMigration(int shardnum)
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		if (!reconfigurable()) return false;
+
+		for (int i = 0; i < shardnum; i++)
+			if (!getShardByID(i))
+				return false;
+
+		Layout layout = *layout_.load();
+		layout.shardnum = shardnum;
+		layout.build();
+
+		layouts_.push_back(std::make_shared<Layout>(layout));
+		next_layout_ = layouts_.back().get();
+		return true;
+	}
+
+	bool isMigrating() { return next_layout_.load() != NULL; }
+
+	bool commitMigration()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		const Layout* next = next_layout_.load();
+		if (!next) return false;
+
+		layout_ = next;
+		next_layout_ = NULL;
+		return true;
+	}
+
+	void abortMigration()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		next_layout_ = NULL;
+	}
+
+	//
+	// shard id in the layout being migrated to, -1 if not migrating
+	//
+	int nextShardIDByHash(uint32_t hashcode)
+	{
+		const Layout* next = next_layout_.load();
+		return next ? next->shardIDByHash(hashcode) : -1;
+	}
+
+	//
+	// shards that must receive a write : owner, and the new owner when
+	// migrating and different. returns the number of ids (1 or 2)
+	//
+	int writeShardIDsByHash(uint32_t hashcode, int ids[2])
+	{
+		ids[0] = shardIDByHash(hashcode);
+		ids[1] = nextShardIDByHash(hashcode);
+		return (ids[1] >= 0 && ids[1] != ids[0]) ? 2 : 1;
+	}
+
+	int writeShardIDsByKey(const std::string& key, int ids[2])
+	{
+		return writeShardIDsByHash(Hash::hash(key), ids);
+	}
+
+	int shardIDByKey(const std::string& key)
+	{
+		return shardIDByHash(Hash::hash(key));
+	}
+
+	//
+	// IDs with the shard embedded (shardid.h), no hashing, not affected
+	// by the layout or migrations
+	//
+	int shardIDByEmbeddedID(uint64_t id)
+	{
+		return ShardID::shard(id);
+	}
+
+	Shard* getShardByEmbeddedID(uint64_t id)
+	{
+		return getShardByID(shardIDByEmbeddedID(id));
+	}
+
+	int nextShardIDByKey(const std::string& key)
+	{
+		return nextShardIDByHash(Hash::hash(key));
+	}
+
+	//
+	// shard id a row stored in `shard` moves to while migrating, -1 if it
+	// stays or `shard` is not its owner (a stale copy left by an earlier
+	// migration, never copied again)
+	//
+	int movingShardIDByHash(uint32_t hashcode, int shard)
+	{
+		if (shardIDByHash(hashcode) != shard) return -1;
+
+		int next = nextShardIDByHash(hashcode);
+		return next != shard ? next : -1;
+	}
+
+	int movingShardIDByKey(const std::string& key, int shard)
+	{
+		return movingShardIDByHash(Hash::hash(key), shard);
 	}
 
 protected:
-	Shards shards_;
+	// mutex_ held
+	bool reconfigurable()
+	{
+		return !next_layout_.load() && layouts_.size() < kMaxLayouts;
+	}
 
-	// total shards number(best to be 2^n)
-	int shardnum_;
+	// mutex_ held (or constructing)
+	void publish(const Layout& layout)
+	{
+		layouts_.push_back(std::make_shared<Layout>(layout));
+		layouts_.back()->build();
+		layout_ = layouts_.back().get();
+	}
+
+	// mutex_ held
+	void publishShards(const Shards& shards)
+	{
+		tables_.push_back(std::make_shared<Shards>(shards));
+		shards_.store(tables_.back().get(), std::memory_order_release);
+	}
+
+	//
+	// removes all the shards, returns them to be released
+	//
+	Shards clearShards()
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		Shards shards = *shards_.load();
+		publishShards(Shards());
+		return shards;
+	}
+
+	// swapped like layout_, the retired tables stay in tables_ : one per
+	// addShard() and clearShards()
+	std::atomic<const Shards*> shards_;
+	std::vector<std::shared_ptr<Shards> > tables_;
+
+	// layout_ is swapped atomically, the retired layouts stay in layouts_
+	// so a reader never sees a freed one (each Ketama layout holds a ring)
+	std::atomic<const Layout*> layout_;
+	std::atomic<const Layout*> next_layout_;
+	std::vector<std::shared_ptr<Layout> > layouts_;
+	std::mutex mutex_;
 };
 
-#endif // __COMMON_SHARDING_H
\ No newline at end of file
+#endif // __COMMON_SHARDING_H
@@ -0,0 +1,366 @@
+#ifndef TINYWORLD_SHARDSTATS_H
+#define TINYWORLD_SHARDSTATS_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include "hashkit.h"
+#include "latency.h"
+#include "shardid.h"
+#include "tinylogger.h"
+
+//
+// Count-min sketch: approximate access count of any key in fixed memory
+// (depth x width counters), never under-estimates. Lock-free.
+//
+class CountMinSketch {
+public:
+    // width is rounded up to a power of 2
+    explicit CountMinSketch(size_t width = 2048, size_t depth = 4)
+            : width_(roundup(width)), depth_(depth ? depth : 1),
+              counters_(new std::atomic<uint32_t>[width_ * depth_]) {
+        for (size_t i = 0; i < width_ * depth_; ++i)
+            counters_[i] = 0;
+    }
+
+    // returns the estimate after adding
+    uint32_t add(const std::string &key, uint32_t count = 1) {
+        uint32_t h1 = hash_murmur(key.data(), key.size());
+        uint32_t h2 = rehash(h1);
+
+        uint32_t estimate = UINT32_MAX;
+        for (size_t row = 0; row < depth_; ++row) {
+            uint32_t value = counters_[index(row, h1, h2)].fetch_add(count, std::memory_order_relaxed) + count;
+            estimate = std::min(estimate, value);
+        }
+        return estimate;
+    }
+
+    uint32_t estimate(const std::string &key) const {
+        uint32_t h1 = hash_murmur(key.data(), key.size());
+        uint32_t h2 = rehash(h1);
+
+        uint32_t estimate = UINT32_MAX;
+        for (size_t row = 0; row < depth_; ++row)
+            estimate = std::min(estimate, counters_[index(row, h1, h2)].load(std::memory_order_relaxed));
+        return estimate;
+    }
+
+    // aging: old accesses weigh half, increments racing with it may be lost
+    void halve() {
+        for (size_t i = 0; i < width_ * depth_; ++i)
+            counters_[i].store(counters_[i].load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+    }
+
+    size_t width() const { return width_; }
+
+    size_t depth() const { return depth_; }
+
+protected:
+    size_t index(size_t row, uint32_t h1, uint32_t h2) const {
+        return row * width_ + ((h1 + row * h2) & (width_ - 1));
+    }
+
+    // second hash for the rows (double hashing), murmur3's finalizer
+    static uint32_t rehash(uint32_t h) {
+        h ^= 0x9e3779b9;
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        h ^= h >> 16;
+        return h | 1;
+    }
+
+    static size_t roundup(size_t n) {
+        size_t width = 1;
+        while (width < n)
+            width <<= 1;
+        return width;
+    }
+
+private:
+    size_t width_;
+    size_t depth_;
+    std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+};
+
+//
+// Top-K hot keys: a count-min sketch counts every key, the K keys with the
+// highest estimates are kept. Only a key reaching the current top-K
+// threshold takes the lock. Counts are halved every window (seconds), so
+// the ranking follows the recent traffic.
+//
+//   tracker.record(key, shard);
+//   for (auto &hot : tracker.top()) ...
+//
+class HotKeyTracker {
+public:
+    struct HotKey {
+        std::string key;
+        int shard;
+        uint32_t count;
+    };
+
+    explicit HotKeyTracker(size_t topk = 20, unsigned int window = 60, size_t width = 2048, size_t depth = 4)
+            : topk_(topk ? topk : 1), window_(window ? window : 1), sketch_(width, depth),
+              threshold_(0), epoch_(now()) {}
+
+    void record(const std::string &key, int shard = -1) {
+        age();
+
+        uint32_t count = sketch_.add(key);
+        if (count < threshold_.load(std::memory_order_relaxed))
+            return;
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::vector<HotKey>::iterator it = std::find_if(top_.begin(), top_.end(), [&key](const HotKey &hot) {
+            return hot.key == key;
+        });
+
+        if (it != top_.end()) {
+            it->count = std::max(it->count, count);
+            it->shard = shard;
+        } else if (top_.size() < topk_) {
+            top_.push_back(HotKey{key, shard, count});
+        } else {
+            std::vector<HotKey>::iterator min = minimum();
+            if (count <= min->count)
+                return;
+            *min = HotKey{key, shard, count};
+        }
+
+        threshold_ = top_.size() < topk_ ? 0 : minimum()->count;
+    }
+
+    uint32_t estimate(const std::string &key) const { return sketch_.estimate(key); }
+
+    // hottest first
+    std::vector<HotKey> top(size_t n = 0) {
+        std::vector<HotKey> keys;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            keys = top_;
+        }
+
+        std::sort(keys.begin(), keys.end(), [](const HotKey &a, const HotKey &b) { return a.count > b.count; });
+        if (n && keys.size() > n)
+            keys.resize(n);
+        return keys;
+    }
+
+protected:
+    // mutex_ held
+    std::vector<HotKey>::iterator minimum() {
+        return std::min_element(top_.begin(), top_.end(), [](const HotKey &a, const HotKey &b) {
+            return a.count < b.count;
+        });
+    }
+
+    void age() {
+        int64_t epoch = now();
+        int64_t old = epoch_.load(std::memory_order_relaxed);
+        if (old == epoch || !epoch_.compare_exchange_strong(old, epoch))
+            return;
+
+        sketch_.halve();
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto &hot : top_)
+            hot.count /= 2;
+        threshold_ = top_.size() < topk_ ? 0 : minimum()->count;
+    }
+
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count() / window_;
+    }
+
+private:
+    size_t topk_;
+    unsigned int window_;
+    CountMinSketch sketch_;
+
+    std::atomic<uint32_t> threshold_;
+    std::atomic<int64_t> epoch_;
+
+    std::mutex mutex_;
+    std::vector<HotKey> top_;
+};
+
+//
+// Per-shard QPS and latency, and the hot keys of all the shards:
+//
+//   stats.record(shard, elapsed_us, ok);  // every request to a shard
+//   stats.touch(shard, key);             // every access routed by key
+//
+//   stats.shard(3).qps / .p99
+//   stats.hotKeys(10)
+//   stats.startDump(60);                 // LOG_INFO the report every minute
+//
+// Lock-free on the request path except for keys entering the top-K.
+//
+class ShardingStats {
+public:
+    struct ShardSummary {
+        int shard = -1;
+        double qps = 0;
+        uint64_t requests = 0;
+        uint64_t errors = 0;
+        uint64_t p50 = 0;
+        uint64_t p99 = 0;
+    };
+
+    typedef HotKeyTracker::HotKey HotKey;
+
+    // window (seconds) of the latencies and QPS, the hot keys age every 6 windows
+    explicit ShardingStats(unsigned int window = 10, size_t topk = 20)
+            : window_(window ? window : 1), keys_(topk, window_ * 6) {
+        for (size_t i = 0; i < ShardID::kMaxShards; ++i)
+            shards_[i] = nullptr;
+    }
+
+    ~ShardingStats() {
+        stopDump();
+        for (size_t i = 0; i < ShardID::kMaxShards; ++i)
+            delete shards_[i].load();
+    }
+
+    void record(int shard, uint64_t us, bool ok = true) {
+        Shard *stats = get(shard);
+        if (!stats) return;
+
+        stats->latency.record(us);
+        stats->requests.fetch_add(1, std::memory_order_relaxed);
+        if (!ok)
+            stats->errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void touch(int shard, const std::string &key) { keys_.record(key, shard); }
+
+    uint32_t keyCount(const std::string &key) const { return keys_.estimate(key); }
+
+    std::vector<HotKey> hotKeys(size_t n = 0) { return keys_.top(n); }
+
+    ShardSummary shard(int shard) {
+        ShardSummary summary;
+        summary.shard = shard;
+
+        Shard *stats = (shard >= 0 && shard < ShardID::kMaxShards) ? shards_[shard].load() : nullptr;
+        if (stats) {
+            summary.qps = stats->latency.rate();
+            summary.requests = stats->requests;
+            summary.errors = stats->errors;
+            summary.p50 = stats->latency.percentile(50);
+            summary.p99 = stats->latency.percentile(99);
+        }
+        return summary;
+    }
+
+    // the shards having traffic, busiest first
+    std::vector<ShardSummary> shards() {
+        std::vector<ShardSummary> summaries;
+        for (int i = 0; i < ShardID::kMaxShards; ++i) {
+            if (shards_[i].load())
+                summaries.push_back(shard(i));
+        }
+
+        std::sort(summaries.begin(), summaries.end(), [](const ShardSummary &a, const ShardSummary &b) {
+            return a.qps > b.qps;
+        });
+        return summaries;
+    }
+
+    std::string dump(size_t keys = 10) {
+        std::string text;
+        char line[256];
+
+        for (auto &summary : shards()) {
+            snprintf(line, sizeof(line), "shard %d: qps=%.1f p50=%lluus p99=%lluus requests=%llu errors=%llu\n",
+                     summary.shard, summary.qps,
+                     (unsigned long long) summary.p50, (unsigned long long) summary.p99,
+                     (unsigned long long) summary.requests, (unsigned long long) summary.errors);
+            text += line;
+        }
+
+        for (auto &hot : hotKeys(keys)) {
+            snprintf(line, sizeof(line), "hot key: %s shard=%d count~%u\n", hot.key.c_str(), hot.shard, hot.count);
+            text += line;
+        }
+        return text;
+    }
+
+    //
+    // dump() to the log every interval seconds in a background thread
+    //
+    void startDump(unsigned int interval) {
+        stopDump();
+
+        std::lock_guard<std::mutex> guard(dump_mutex_);
+        dumping_ = true;
+        dumper_ = std::thread([this, interval]() {
+            std::unique_lock<std::mutex> lock(dump_mutex_);
+            while (!dump_cond_.wait_for(lock, std::chrono::seconds(interval ? interval : 1),
+                                        [this]() { return !dumping_; })) {
+                lock.unlock();
+                LOG_INFO("sharding", "stats:\n%s", dump().c_str());
+                lock.lock();
+            }
+        });
+    }
+
+    void stopDump() {
+        {
+            std::lock_guard<std::mutex> guard(dump_mutex_);
+            dumping_ = false;
+            dump_cond_.notify_all();
+        }
+
+        if (dumper_.joinable())
+            dumper_.join();
+    }
+
+protected:
+    struct Shard {
+        explicit Shard(unsigned int window) : latency(window), requests(0), errors(0) {}
+
+        LatencyTracker latency;
+        std::atomic<uint64_t> requests;
+        std::atomic<uint64_t> errors;
+    };
+
+    Shard *get(int shard) {
+        if (shard < 0 || shard >= ShardID::kMaxShards)
+            return nullptr;
+
+        Shard *stats = shards_[shard].load(std::memory_order_acquire);
+        if (stats) return stats;
+
+        Shard *created = new Shard(window_);
+        if (shards_[shard].compare_exchange_strong(stats, created))
+            return created;
+
+        delete created;
+        return stats;
+    }
+
+private:
+    unsigned int window_;
+    HotKeyTracker keys_;
+    std::atomic<Shard *> shards_[ShardID::kMaxShards];
+
+    std::mutex dump_mutex_;
+    std::condition_variable dump_cond_;
+    bool dumping_ = false;
+    std::thread dumper_;
+};
+
+#endif //TINYWORLD_SHARDSTATS_H
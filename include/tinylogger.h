@@ -33,6 +33,25 @@
 
 #define LOG_LENGTH_MAX 1024
 
+//
+// Levels below TINYLOGGER_MIN_LEVEL are compiled out: the arguments are
+// still type-checked but never evaluated, no code is generated.
+//
+//   -DTINYLOGGER_MIN_LEVEL=TINYLOGGER_LEVEL_INFO
+//
+#define TINYLOGGER_LEVEL_TRACE 1
+#define TINYLOGGER_LEVEL_DEBUG 2
+#define TINYLOGGER_LEVEL_INFO  3
+#define TINYLOGGER_LEVEL_WARN  4
+#define TINYLOGGER_LEVEL_ERROR 5
+#define TINYLOGGER_LEVEL_FATAL 6
+
+#ifndef TINYLOGGER_MIN_LEVEL
+#define TINYLOGGER_MIN_LEVEL TINYLOGGER_LEVEL_TRACE
+#endif
+
+#define TINYLOGGER_COMPILED(level) ((level) >= TINYLOGGER_MIN_LEVEL)
+
 #ifndef TINYLOGGER_LOG4CXX
 #define     TINYLOGGER_SIMPLE
 #endif
@@ -49,81 +68,178 @@
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
 
-#define SIMPLE_LOGGER_TRACE 1
-#define SIMPLE_LOGGER_DEBUG 2
-#define SIMPLE_LOGGER_INFO  3
-#define SIMPLE_LOGGER_WARN  4
-#define SIMPLE_LOGGER_ERROR 5
-#define SIMPLE_LOGGER_FATAL 6
+#define SIMPLE_LOGGER_TRACE TINYLOGGER_LEVEL_TRACE
+#define SIMPLE_LOGGER_DEBUG TINYLOGGER_LEVEL_DEBUG
+#define SIMPLE_LOGGER_INFO  TINYLOGGER_LEVEL_INFO
+#define SIMPLE_LOGGER_WARN  TINYLOGGER_LEVEL_WARN
+#define SIMPLE_LOGGER_ERROR TINYLOGGER_LEVEL_ERROR
+#define SIMPLE_LOGGER_FATAL TINYLOGGER_LEVEL_FATAL
 
 //
-// C printf style
+// The level is checked before the arguments are evaluated: a disabled
+// level costs one compare with SimpleLogger::threshold(), the logger's
+// own level is looked up only when that passes.
 //
-#define LOG_TRACE(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_TRACE, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+#define SIMPLE_LOG(level, loggername, fmt, ...) do { \
+        if (TINYLOGGER_COMPILED(level) && SimpleLogger::enabled(level, loggername)) { \
+            if (SimpleLogger::instance().isBinary()) { \
+                static std::atomic<uint32_t> site_(0); \
+                SimpleLogger::instance().log_binary(site_, level, loggername, __FILE__, __LINE__, fmt, ##__VA_ARGS__); \
+            } else { \
+                SimpleLogger::instance().print_log(level, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
 
-#define LOG_DEBUG(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_DEBUG, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+#define SIMPLE_LOGGER(level, loggername, message) do { \
+        if (TINYLOGGER_COMPILED(level) && SimpleLogger::enabled(level, loggername)) { \
+            std::ostringstream oss_; \
+            oss_ << message; \
+            SimpleLogger::instance().print_log(level, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, "%s", oss_.str().c_str()); \
+        } \
+    } while (0)
 
-#define LOG_INFO(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_INFO, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+//
+// C printf style
+//
+#define LOG_TRACE(loggername, fmt, ...) SIMPLE_LOG(SIMPLE_LOGGER_TRACE, loggername, fmt, ##__VA_ARGS__)
+#define LOG_DEBUG(loggername, fmt, ...) SIMPLE_LOG(SIMPLE_LOGGER_DEBUG, loggername, fmt, ##__VA_ARGS__)
+#define LOG_INFO(loggername, fmt, ...)  SIMPLE_LOG(SIMPLE_LOGGER_INFO,  loggername, fmt, ##__VA_ARGS__)
+#define LOG_WARN(loggername, fmt, ...)  SIMPLE_LOG(SIMPLE_LOGGER_WARN,  loggername, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(loggername, fmt, ...) SIMPLE_LOG(SIMPLE_LOGGER_ERROR, loggername, fmt, ##__VA_ARGS__)
+#define LOG_FATAL(loggername, fmt, ...) SIMPLE_LOG(SIMPLE_LOGGER_FATAL, loggername, fmt, ##__VA_ARGS__)
 
-#define LOG_WARN(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_WARN, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+//
+// C++ streambuf style
+//
+#define LOGGER_TRACE(loggername, message) SIMPLE_LOGGER(SIMPLE_LOGGER_TRACE, loggername, message)
+#define LOGGER_DEBUG(loggername, message) SIMPLE_LOGGER(SIMPLE_LOGGER_DEBUG, loggername, message)
+#define LOGGER_INFO(loggername, message)  SIMPLE_LOGGER(SIMPLE_LOGGER_INFO,  loggername, message)
+#define LOGGER_WARN(loggername, message)  SIMPLE_LOGGER(SIMPLE_LOGGER_WARN,  loggername, message)
+#define LOGGER_ERROR(loggername, message) SIMPLE_LOGGER(SIMPLE_LOGGER_ERROR, loggername, message)
+#define LOGGER_FATAL(loggername, message) SIMPLE_LOGGER(SIMPLE_LOGGER_FATAL, loggername, message)
 
-#define LOG_ERROR(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_ERROR, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+//
+// threshold of all the loggers, static storage initialized at compile
+// time (no guard on the check)
+//
+template <typename T = void>
+struct SimpleLoggerThreshold
+{
+    static std::atomic<int> value;
+};
 
-#define LOG_FATAL(loggername, fmt, ...) \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_FATAL, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, fmt, ##__VA_ARGS__)
+template <typename T>
+std::atomic<int> SimpleLoggerThreshold<T>::value(SIMPLE_LOGGER_TRACE);
 
 //
-// C++ streambuf style
+// Asynchronous mode: the logging threads only format the message into a
+// fixed-size record of their own lock-free ring (single producer, single
+// consumer), a background thread adds the timestamp and the prefix and
+// writes the records in batches.
 //
-#define LOGGER_TRACE(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_TRACE, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
-    }
+//   SimpleLogger::instance().startAsync("server.log");     // "" : stdout
+//   SimpleLogger::instance().startAsync("server.log", 4096, SimpleLogger::kOverflow_Block);
+//   ...
+//   SimpleLogger::instance().stopAsync();                  // drains the rings
+//
+// Timestamps come from a clock the background thread refreshes every few
+// ms, no clock call on the logging threads.
+//
+// Binary mode (kFormat_Binary): LOG_* do not format at all, the call site
+// id and the raw arguments (integers as varints, doubles, strings by copy)
+// are stored, the format strings are written once per file. Render the
+// file with example/tinylog_decode.
+//
+//   file    : session...  (a file opened again is appended to)
+//   session : 'H' "TLOG" version(1) entry...
+//   entry   : 'D' site level logger file line fmt    call site definition
+//           | 'R' site time size payload             LOG_* record
+//           | 'T' level time logger text             preformatted (LOGGER_*)
+//   payload : ('i' zigzag | 'u' varint | 'd' double | 's' string | 'p' varint)...
+//   site, line, size, time: varint, time is the zigzag delta (ms) to the
+//   previous entry, string: varint length + bytes
+//
+struct SimpleLogger
+{
+    enum Format
+    {
+        kFormat_Text,
+        kFormat_Binary,
+    };
 
-#define LOGGER_DEBUG(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_DEBUG, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
+    enum OverflowPolicy
+    {
+        kOverflow_Drop,     // the record is lost, counted in dropped()
+        kOverflow_Block,    // the logging thread waits for room
+    };
+
+    static SimpleLogger& instance()
+    {
+        static SimpleLogger logger_instance;
+        return logger_instance;
     }
 
-#define LOGGER_INFO(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_INFO, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
+    ~SimpleLogger()
+    {
+        stopAsync();
     }
 
-#define LOGGER_WARN(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_WARN, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
+    //
+    // Runtime levels: the default of all the loggers, and per logger name
+    //
+    //   SimpleLogger::instance().setLevel(SIMPLE_LOGGER_INFO);
+    //   SimpleLogger::instance().setLevel("TinyMySqlORM", SIMPLE_LOGGER_TRACE);
+    //
+    void setLevel(int level)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        default_level_ = level;
+        publishLevels(levels());
     }
 
-#define LOGGER_ERROR(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_ERROR, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
+    void setLevel(const std::string& loggername, int level)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        Levels levels_copy = levels();
+        levels_copy[loggername] = level;
+        publishLevels(levels_copy);
     }
 
-#define LOGGER_FATAL(loggername, message) { \
-        std::ostringstream oss_; \
-        oss_ << message; \
-        SimpleLogger::instance().print_log(SIMPLE_LOGGER_FATAL, loggername, __FILE__, __LINE__, __PRETTY_FUNCTION__, oss_.str().c_str()); \
+    int level(const char* loggername)
+    {
+        const Levels* levels = levels_.load(std::memory_order_acquire);
+        if (levels && loggername)
+        {
+            Levels::const_iterator it = levels->find(loggername);
+            if (it != levels->end())
+                return it->second;
+        }
+        return default_level_;
     }
 
+    static int threshold() { return SimpleLoggerThreshold<>::value.load(std::memory_order_relaxed); }
 
-struct SimpleLogger
-{
-    static SimpleLogger& instance()
+    static bool enabled(int level, const char* loggername)
     {
-        static SimpleLogger logger_instance;
-        return logger_instance;
+        if (__builtin_expect(level < threshold(), 1))
+            return false;
+        return level >= instance().level(loggername);
     }
 
     const char* level_name(int level)
@@ -147,6 +263,29 @@ struct SimpleLogger
                    const char *func,
                    const char *fmt, ...)
     {
+        if (async_.load(std::memory_order_acquire))
+        {
+            Record* record = claim();
+            if (!record)
+                return;
+
+            va_list ap;
+            va_start(ap, fmt);
+            vsnprintf(record->text, sizeof(record->text), fmt, ap);
+            va_end(ap);
+
+            record->site = 0;
+            record->time = clock_ms_.load(std::memory_order_relaxed);
+            record->level = level;
+            strncpy(record->logger, loggername, sizeof(record->logger) - 1);
+            record->logger[sizeof(record->logger) - 1] = '\0';
+            publish();
+
+            if (level >= SIMPLE_LOGGER_FATAL)
+                flush();
+            return;
+        }
+
         char buf[LOG_LENGTH_MAX] = "";
         va_list ap;
         va_start(ap, fmt);
@@ -167,6 +306,703 @@ struct SimpleLogger
                   << std::endl;
         output->flush();
     }
+
+    //
+    // binary mode: the site id and the raw arguments, formatted offline
+    //
+    template <typename... Args>
+    void log_binary(std::atomic<uint32_t>& site, int level, const char* loggername,
+                    const char* file, int line, const char* fmt, const Args&... args)
+    {
+        uint32_t id = site.load(std::memory_order_acquire);
+        if (!id)
+            id = addSite(site, level, loggername, file, line, fmt);
+
+        Record* record = claim();
+        if (!record)
+            return;
+
+        Encoder encoder(record->text, sizeof(record->text));
+        encode(encoder, args...);
+
+        record->site = id;
+        record->size = (uint32_t) (encoder.p - record->text);
+        record->time = clock_ms_.load(std::memory_order_relaxed);
+        record->level = level;
+        publish();
+
+        if (level >= SIMPLE_LOGGER_FATAL)
+            flush();
+    }
+
+    //
+    // printf of a binary payload, the arguments are matched with the
+    // conversions of fmt in order
+    //
+    static std::string format(const char* fmt, const char* payload, size_t size)
+    {
+        Decoder decoder(payload, payload + size);
+        std::string text;
+        char buf[LOG_LENGTH_MAX];
+
+        for (const char* p = fmt; *p; ++p)
+        {
+            if (*p != '%')
+            {
+                text += *p;
+                continue;
+            }
+
+            if (p[1] == '%')
+            {
+                text += '%';
+                ++p;
+                continue;
+            }
+
+            // %[flags][width][.precision][length]conversion
+            std::string spec = "%";
+            const char* q = p + 1;
+            while (*q && strchr("-+ #0", *q))
+                spec += *q++;
+            for (int part = 0; part < 2; ++part)
+            {
+                if (part == 1)
+                {
+                    if (*q != '.') break;
+                    spec += *q++;
+                }
+
+                if (*q == '*')
+                {
+                    Arg arg = decoder.next();
+                    spec += std::to_string((int) arg.i);
+                    ++q;
+                }
+                while (*q >= '0' && *q <= '9')
+                    spec += *q++;
+            }
+            while (*q && strchr("hlLqjzt", *q))
+                ++q;
+
+            char conversion = *q;
+            if (!conversion) break;
+            p = q;
+
+            Arg arg = decoder.next();
+            switch (conversion)
+            {
+                case 'd': case 'i':
+                    snprintf(buf, sizeof(buf), (spec + "ll" + conversion).c_str(), (long long) arg.i);
+                    break;
+                case 'u': case 'o': case 'x': case 'X':
+                    snprintf(buf, sizeof(buf), (spec + "ll" + conversion).c_str(), (unsigned long long) arg.u);
+                    break;
+                case 'c':
+                    snprintf(buf, sizeof(buf), (spec + conversion).c_str(), (int) arg.i);
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    snprintf(buf, sizeof(buf), (spec + conversion).c_str(), arg.d);
+                    break;
+                case 's':
+                    snprintf(buf, sizeof(buf), (spec + conversion).c_str(), arg.s.c_str());
+                    break;
+                case 'p':
+                    snprintf(buf, sizeof(buf), (spec + conversion).c_str(), (void*) (uintptr_t) arg.u);
+                    break;
+                default:
+                    buf[0] = '\0';
+                    break;
+            }
+            text += buf;
+        }
+        return text;
+    }
+
+    //
+    // capacity: records per thread's ring (rounded up to 2^n), a record
+    // is about LOG_LENGTH_MAX bytes
+    //
+    bool startAsync(const std::string& filename = "", size_t capacity = 1024,
+                    OverflowPolicy policy = kOverflow_Drop, Format format = kFormat_Text)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (async_) return false;
+
+        file_ = filename.empty() ? stdout : fopen(filename.c_str(), format == kFormat_Binary ? "ab" : "a");
+        if (!file_)
+        {
+            file_ = NULL;
+            return false;
+        }
+
+        capacity_ = 1;
+        while (capacity_ < capacity)
+            capacity_ <<= 1;
+
+        policy_ = policy;
+        stopping_ = false;
+        dropped_ = 0;
+        clock_ms_ = now_ms();
+        ++generation_;
+
+        // the mode goes by value: stopAsync() may reset binary_ before the thread runs
+        bool binary = (format == kFormat_Binary);
+        binary_ = binary;
+        writer_ = std::thread([this, binary]() { run(binary); });
+        async_ = true;
+        return true;
+    }
+
+    void stopAsync()
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (!async_) return;
+
+            async_ = false;
+            binary_ = false;
+            stopping_ = true;
+            cond_.notify_all();
+        }
+
+        if (writer_.joinable())
+            writer_.join();
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        rings_.clear();
+        if (file_ && file_ != stdout)
+            fclose(file_);
+        file_ = NULL;
+    }
+
+    // waits until the records logged so far are written
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        uint64_t target = ++flush_requested_;
+        cond_.notify_all();
+        cond_.wait(lock, [this, target]() { return flush_done_ >= target || !async_; });
+    }
+
+    bool isAsync() { return async_; }
+
+    bool isBinary() { return binary_.load(std::memory_order_relaxed); }
+
+    // records dropped since startAsync()
+    uint64_t dropped() { return dropped_; }
+
+protected:
+    typedef std::map<std::string, int> Levels;
+
+    // mutex_ held
+    Levels levels()
+    {
+        const Levels* levels = levels_.load();
+        return levels ? *levels : Levels();
+    }
+
+    // mutex_ held, the threshold is the lowest level of all
+    void publishLevels(const Levels& levels)
+    {
+        level_tables_.push_back(std::make_shared<Levels>(levels));
+        levels_.store(level_tables_.back().get(), std::memory_order_release);
+
+        int threshold = default_level_;
+        for (Levels::const_iterator it = levels.begin(); it != levels.end(); ++it)
+            threshold = std::min(threshold, it->second);
+        SimpleLoggerThreshold<>::value.store(threshold, std::memory_order_relaxed);
+    }
+
+    struct Record
+    {
+        int64_t time;
+        int level;
+        uint32_t site;      // binary: call site id, 0: text record
+        uint32_t size;      // binary: payload size
+        char logger[32];
+        char text[LOG_LENGTH_MAX];
+    };
+
+    struct Site
+    {
+        int level;
+        std::string logger;
+        std::string file;
+        int line;
+        std::string fmt;
+    };
+
+    uint32_t addSite(std::atomic<uint32_t>& site, int level, const char* loggername,
+                     const char* file, int line, const char* fmt)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        uint32_t id = site.load();
+        if (!id)
+        {
+            Site s = {level, loggername ? loggername : "", file ? file : "", line, fmt ? fmt : ""};
+            sites_.push_back(s);
+            id = (uint32_t) sites_.size();
+            site.store(id, std::memory_order_release);
+        }
+        return id;
+    }
+
+    //
+    // binary payload
+    //
+    struct Encoder
+    {
+        Encoder(char* buf, size_t size) : p(buf), end(buf + size) {}
+
+        bool room(size_t n) { return (size_t) (end - p) >= n; }
+
+        void put(char c) { *p++ = c; }
+
+        void varint(uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                *p++ = (char) (v | 0x80);
+                v >>= 7;
+            }
+            *p++ = (char) v;
+        }
+
+        char* p;
+        char* end;
+    };
+
+    static void encode(Encoder&) {}
+
+    template <typename T, typename... Rest>
+    static void encode(Encoder& e, const T& value, const Rest&... rest)
+    {
+        encodeArg(e, value);
+        encode(e, rest...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    encodeArg(Encoder& e, T value)
+    {
+        if (!e.room(11)) return;
+        int64_t v = value;
+        e.put('i');
+        e.varint(((uint64_t) v << 1) ^ (uint64_t) (v >> 63));
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    encodeArg(Encoder& e, T value)
+    {
+        if (!e.room(11)) return;
+        e.put('u');
+        e.varint((uint64_t) value);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_enum<T>::value>::type
+    encodeArg(Encoder& e, T value)
+    {
+        encodeArg(e, (int64_t) value);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    encodeArg(Encoder& e, T value)
+    {
+        if (!e.room(9)) return;
+        double d = value;
+        e.put('d');
+        memcpy(e.p, &d, sizeof(d));
+        e.p += sizeof(d);
+    }
+
+    static void encodeArg(Encoder& e, const char* s)
+    {
+        if (!e.room(12)) return;
+        size_t len = s ? strlen(s) : 0;
+        len = std::min(len, (size_t) (e.end - e.p) - 11);
+        e.put('s');
+        e.varint(len);
+        memcpy(e.p, s, len);
+        e.p += len;
+    }
+
+    static void encodeArg(Encoder& e, char* s) { encodeArg(e, (const char*) s); }
+
+    template <typename T>
+    static void encodeArg(Encoder& e, T* ptr)
+    {
+        if (!e.room(11)) return;
+        e.put('p');
+        e.varint((uint64_t) (uintptr_t) ptr);
+    }
+
+    struct Arg
+    {
+        int64_t i = 0;
+        uint64_t u = 0;
+        double d = 0;
+        std::string s;
+    };
+
+    struct Decoder
+    {
+        Decoder(const char* begin, const char* end) : p(begin), end(end) {}
+
+        bool varint(uint64_t& v)
+        {
+            v = 0;
+            for (int shift = 0; p < end && shift < 64; shift += 7)
+            {
+                uint8_t b = (uint8_t) *p++;
+                v |= (uint64_t) (b & 0x7f) << shift;
+                if (!(b & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        // missing or mismatched arguments come out as 0 / ""
+        Arg next()
+        {
+            Arg arg;
+            if (p >= end) return arg;
+
+            uint64_t v = 0;
+            switch (*p++)
+            {
+                case 'i':
+                    varint(v);
+                    arg.i = (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+                    arg.u = (uint64_t) arg.i;
+                    arg.d = (double) arg.i;
+                    break;
+                case 'u': case 'p':
+                    varint(v);
+                    arg.u = v;
+                    arg.i = (int64_t) v;
+                    arg.d = (double) v;
+                    break;
+                case 'd':
+                    if (end - p >= (ptrdiff_t) sizeof(double))
+                    {
+                        memcpy(&arg.d, p, sizeof(double));
+                        p += sizeof(double);
+                        arg.i = (int64_t) arg.d;
+                        arg.u = (uint64_t) arg.i;
+                    }
+                    break;
+                case 's':
+                    varint(v);
+                    v = std::min<uint64_t>(v, (uint64_t) (end - p));
+                    arg.s.assign(p, (size_t) v);
+                    p += v;
+                    break;
+                default:
+                    p = end;
+                    break;
+            }
+            return arg;
+        }
+
+        const char* p;
+        const char* end;
+    };
+
+    static void putVarint(std::string& out, uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            out += (char) (v | 0x80);
+            v >>= 7;
+        }
+        out += (char) v;
+    }
+
+    static void putString(std::string& out, const std::string& s)
+    {
+        putVarint(out, s.size());
+        out += s;
+    }
+
+    static void putTime(std::string& out, int64_t time, int64_t& last)
+    {
+        int64_t delta = time - last;
+        last = time;
+        putVarint(out, ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+    }
+
+    struct Ring
+    {
+        explicit Ring(size_t capacity) : records(capacity), head(0), tail(0), closed(false) {}
+
+        std::vector<Record> records;
+        std::atomic<size_t> head;   // next to read, consumer only
+        std::atomic<size_t> tail;   // next to write, producer only
+        std::atomic<bool> closed;   // the thread has exited
+    };
+
+    // the calling thread's ring, closed when the thread exits
+    struct RingHolder
+    {
+        ~RingHolder()
+        {
+            if (ring) ring->closed = true;
+        }
+
+        std::shared_ptr<Ring> ring;
+        uint64_t generation = 0;
+    };
+
+    Ring* ring()
+    {
+        static thread_local RingHolder holder;
+        if (!holder.ring || holder.generation != generation_)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (holder.ring) holder.ring->closed = true;
+            holder.ring = std::make_shared<Ring>(capacity_);
+            holder.generation = generation_;
+            rings_.push_back(holder.ring);
+        }
+        return holder.ring.get();
+    }
+
+    // the next free record of the thread's ring, NULL if dropped
+    Record* claim()
+    {
+        Ring* r = ring();
+        size_t tail = r->tail.load(std::memory_order_relaxed);
+        while (tail - r->head.load(std::memory_order_acquire) >= r->records.size())
+        {
+            if (policy_ == kOverflow_Drop || !async_)
+            {
+                dropped_++;
+                return NULL;
+            }
+
+            cond_.notify_all();
+            std::this_thread::yield();
+        }
+        return &r->records[tail & (r->records.size() - 1)];
+    }
+
+    void publish()
+    {
+        Ring* r = ring();
+        r->tail.store(r->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    static int64_t now_ms()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // background thread
+    void run(bool binary)
+    {
+        std::string batch;
+        TextClock clock;
+        uint64_t reported = 0;
+
+        std::vector<bool> defined;
+        int64_t last_time = 0;
+        if (binary)
+            batch.append("HTLOG\x01", 6);
+
+        for (;;)
+        {
+            clock_ms_.store(now_ms(), std::memory_order_relaxed);
+
+            std::vector<std::shared_ptr<Ring> > rings;
+            uint64_t flush_target;
+            bool stopping;
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                rings = rings_;
+                flush_target = flush_requested_;
+                stopping = stopping_;
+            }
+
+            size_t written = 0;
+            for (size_t i = 0; i < rings.size(); ++i)
+            {
+                Ring* r = rings[i].get();
+                size_t head = r->head.load(std::memory_order_relaxed);
+                size_t tail = r->tail.load(std::memory_order_acquire);
+                for (; head != tail; ++head, ++written)
+                {
+                    const Record& record = r->records[head & (r->records.size() - 1)];
+
+                    if (binary)
+                    {
+                        writeBinary(batch, record, defined, last_time);
+                        continue;
+                    }
+
+                    if (record.site)
+                        writeText(batch, record.time, record.level, record.logger,
+                                  format(site(record.site).fmt.c_str(), record.text, record.size).c_str(), clock);
+                    else
+                        writeText(batch, record.time, record.level, record.logger, record.text, clock);
+                }
+                r->head.store(head, std::memory_order_release);
+            }
+
+            uint64_t dropped = dropped_;
+            if (dropped != reported)
+            {
+                char line[96];
+                snprintf(line, sizeof(line), "%llu records dropped", (unsigned long long) (dropped - reported));
+                if (binary)
+                {
+                    batch += 'T';
+                    batch += (char) SIMPLE_LOGGER_WARN;
+                    putTime(batch, clock_ms_, last_time);
+                    putString(batch, "SimpleLogger");
+                    putString(batch, line);
+                }
+                else
+                {
+                    writeText(batch, clock_ms_, SIMPLE_LOGGER_WARN, "SimpleLogger", line, clock);
+                }
+                reported = dropped;
+            }
+
+            if (!batch.empty())
+            {
+                fwrite(batch.data(), 1, batch.size(), file_);
+                fflush(file_);
+                batch.clear();
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            // the rings of the exited threads, once drained
+            for (size_t i = 0; i < rings_.size();)
+            {
+                Ring* r = rings_[i].get();
+                if (r->closed && r->head.load() == r->tail.load())
+                    rings_.erase(rings_.begin() + i);
+                else
+                    ++i;
+            }
+
+            if (flush_target > flush_done_)
+            {
+                flush_done_ = flush_target;
+                cond_.notify_all();
+            }
+
+            if (stopping)
+                break;
+
+            if (!written)
+                cond_.wait_for(lock, std::chrono::milliseconds(5));
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        flush_done_ = flush_requested_;
+        cond_.notify_all();
+    }
+
+    Site site(uint32_t id)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return id <= sites_.size() ? sites_[id - 1] : Site();
+    }
+
+    // the date and time of the last second formatted
+    struct TextClock
+    {
+        int64_t second = -1;
+        char text[32] = "";
+    };
+
+    // background thread, text mode: one line
+    void writeText(std::string& out, int64_t time, int level, const char* logger, const char* text,
+                   TextClock& clock)
+    {
+        int64_t second = time / 1000;
+        if (second != clock.second)
+        {
+            std::time_t t = (std::time_t) second;
+            std::strftime(clock.text, sizeof(clock.text), "%Y-%m-%d %H:%M:%S", std::localtime(&t));
+            clock.second = second;
+        }
+
+        char prefix[128];
+        snprintf(prefix, sizeof(prefix), "%s.%03d %5s: [%s] - ",
+                 clock.text, (int) (time % 1000), level_name(level), logger);
+        out += prefix;
+        out += text;
+        out += '\n';
+    }
+
+    // background thread, binary mode
+    void writeBinary(std::string& out, const Record& record, std::vector<bool>& defined, int64_t& last_time)
+    {
+        if (!record.site)
+        {
+            out += 'T';
+            out += (char) record.level;
+            putTime(out, record.time, last_time);
+            putString(out, record.logger);
+            putString(out, record.text);
+            return;
+        }
+
+        if (record.site >= defined.size() || !defined[record.site])
+        {
+            Site def = site(record.site);
+            out += 'D';
+            putVarint(out, record.site);
+            out += (char) def.level;
+            putString(out, def.logger);
+            putString(out, def.file);
+            putVarint(out, (uint64_t) def.line);
+            putString(out, def.fmt);
+
+            if (record.site >= defined.size())
+                defined.resize(record.site + 1, false);
+            defined[record.site] = true;
+        }
+
+        out += 'R';
+        putVarint(out, record.site);
+        putTime(out, record.time, last_time);
+        putVarint(out, record.size);
+        out.append(record.text, record.size);
+    }
+
+private:
+    std::atomic<bool> async_{false};
+    std::atomic<bool> binary_{false};
+    std::atomic<int64_t> clock_ms_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> generation_{0};
+
+    // per logger levels, copied on write, the old copies are kept
+    std::atomic<int> default_level_{SIMPLE_LOGGER_TRACE};
+    std::atomic<const Levels*> levels_{NULL};
+    std::vector<std::shared_ptr<Levels> > level_tables_;
+
+    size_t capacity_ = 1024;
+    OverflowPolicy policy_ = kOverflow_Drop;
+    FILE* file_ = NULL;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::shared_ptr<Ring> > rings_;
+    std::vector<Site> sites_;
+    uint64_t flush_requested_ = 0;
+    uint64_t flush_done_ = 0;
+    bool stopping_ = false;
+    std::thread writer_;
 };
 
 
@@ -208,98 +1044,110 @@ using log4cxx::PropertyConfigurator;
 // C printf style
 //
 #define LOG_TRACE(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isTraceEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getTrace(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_TRACE)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isTraceEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getTrace(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 #define LOG_DEBUG(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isDebugEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getDebug(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_DEBUG)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isDebugEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getDebug(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 #define LOG_INFO(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isInfoEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getInfo(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_INFO)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isInfoEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getInfo(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 #define LOG_WARN(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isWarnEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getWarn(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_WARN)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isWarnEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getWarn(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 #define LOG_ERROR(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isErrorEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getError(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_ERROR)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isErrorEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getError(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 #define LOG_FATAL(loggername, fmt, ...) { \
-        log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-        if (LOG4CXX_UNLIKELY(logger_->isFatalEnabled())) {\
-            char buf_[LOG_LENGTH_MAX] = ""; \
-            snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
-            logger_->forcedLog(log4cxx::Level::getFatal(), buf_, LOG4CXX_LOCATION); \
-        }}
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_FATAL)) { \
+            log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
+            if (LOG4CXX_UNLIKELY(logger_->isFatalEnabled())) {\
+                char buf_[LOG_LENGTH_MAX] = ""; \
+                snprintf(buf_, sizeof(buf_), fmt, ##__VA_ARGS__ ); \
+                logger_->forcedLog(log4cxx::Level::getFatal(), buf_, LOG4CXX_LOCATION); \
+            }}}
 
 
 //
 // C++ streambuf style
 //
 #define LOGGER_TRACE(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isTraceEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_TRACE)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getTrace(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isTraceEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getTrace(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #define LOGGER_DEBUG(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isDebugEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_DEBUG)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getDebug(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isDebugEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getDebug(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #define LOGGER_INFO(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isInfoEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_INFO)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getInfo(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isInfoEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getInfo(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #define LOGGER_WARN(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isWarnEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_WARN)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getWarn(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isWarnEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getWarn(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #define LOGGER_ERROR(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isErrorEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_ERROR)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getError(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isErrorEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getError(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #define LOGGER_FATAL(loggername, message) { \
-        if (LOG4CXX_UNLIKELY(logger->isFatalEnabled())) {\
-            log4cxx::helpers::MessageBuffer oss_; \
+        if (TINYLOGGER_COMPILED(TINYLOGGER_LEVEL_FATAL)) { \
             log4cxx::LoggerPtr logger_(log4cxx::Logger::getLogger(loggername)); \
-            logger_->forcedLog(::log4cxx::Level::getFatal(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-        }}
+            if (LOG4CXX_UNLIKELY(logger_->isFatalEnabled())) {\
+                log4cxx::helpers::MessageBuffer oss_; \
+                logger_->forcedLog(::log4cxx::Level::getFatal(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+            }}}
 
 #endif // TINYLOGGER_LOG4CXX
 
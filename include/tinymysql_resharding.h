@@ -0,0 +1,191 @@
+#ifndef TINYWORLD_TINYMYSQL_RESHARDING_H
+#define TINYWORLD_TINYMYSQL_RESHARDING_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include "tinymysql.h"
+
+//
+// Online resharding over MySqlShardingPool, e.g. 8 -> 16 shards:
+//
+//   MySqlShardingPool *pool = MySqlShardingPool::instance();
+//   pool->addShardings(urls_of_shard_8_to_15);
+//
+//   MySqlResharding resharding(pool, 16);
+//   resharding.addTable("PLAYER", "ID", "ID", "ID,NAME,AGE,WEAPONS");
+//   resharding.start();     // background: dual-write, copy, verify, switch
+//   ...
+//   resharding.wait();
+//
+// Steps:
+//   1. begin   - pool->beginMigration(16), writes go to old and new owners
+//                (writes through writeShardIDsByKey / the sharded ORM)
+//   2. copy    - keyset chunks of every old shard, rows whose owner changes
+//                are copied to the new owner (INSERT IGNORE, so rows already
+//                dual-written are kept), throttled between chunks. Rows the
+//                shard does not own (stale copies of an earlier migration)
+//                are skipped, here and in verify
+//   3. verify  - CRC32 of every moved row on both sides, the mismatched or
+//                missing rows are copied again (REPLACE); the rows of the
+//                moved keyspace missing on the old owner (deleted after their
+//                chunk was copied) are deleted from the new owner; until clean
+//   4. switch  - the rows of the dual-writes failed on their new owner
+//                (MySqlShardingPool::dualWriteFailed) are copied again, then
+//                pool->commitMigrationIfClean(), routing changes atomically
+//   5. purge   - (default, setPurge(false) to keep them) delete the moved
+//                rows from the old owners, only the ones present on their
+//                new owner. Until purged, countFromAllShards counts them
+//                twice (loadFromAllShards drops the copies)
+//
+// Tables routed by an embedded shard ID (shardid.h) never move, add them
+// with embedded = true (they are skipped) or not at all.
+//
+// The cluster keeps serving traffic during all the steps.
+//
+class MySqlResharding {
+public:
+    enum State {
+        kState_Idle,
+        kState_Copying,
+        kState_Verifying,
+        kState_Switched,
+        kState_Done,
+        kState_Failed,
+    };
+
+    struct Table {
+        std::string name;      // table name
+        std::string pkey;      // single-column primary key, used for keyset paging
+        std::string shardkey;  // column hashed to route the row
+        std::vector<std::string> fields;  // all the columns to copy
+        size_t pkey_index;
+        size_t shardkey_index;
+    };
+
+    struct Progress {
+        unsigned long rows_scanned = 0;
+        unsigned long rows_copied = 0;
+        unsigned long rows_mismatched = 0;
+        unsigned long rows_fixed = 0;
+        unsigned long rows_orphaned = 0;
+        unsigned long rows_purged = 0;
+        unsigned long chunks = 0;
+    };
+
+    MySqlResharding(MySqlShardingPool *pool, int shardnum);
+
+    ~MySqlResharding();
+
+    //
+    // fields   : "F1,F2,...", must contain pkey and shardkey
+    // embedded : shardkey is an ID with the shard embedded, the table is skipped
+    //
+    bool addTable(const std::string &name,
+                  const std::string &pkey,
+                  const std::string &shardkey,
+                  const std::string &fields,
+                  bool embedded = false);
+
+    //
+    // rows per chunk and sleep time between two chunks (throttling)
+    //
+    void setChunkSize(unsigned int rows) { chunk_size_ = rows; }
+
+    void setChunkInterval(unsigned int ms) { chunk_interval_ = ms; }
+
+    // rounds of verify/fix before giving up
+    void setVerifyRounds(unsigned int rounds) { verify_rounds_ = rounds; }
+
+    // delete the moved rows from the old owners after switching (default)
+    void setPurge(bool purge) { purge_ = purge; }
+
+    //
+    // Run all the steps in this thread / in a background thread
+    //
+    bool run();
+
+    bool start();
+
+    void wait();
+
+    // stop after the current chunk, the migration is aborted
+    void stop() { stopping_ = true; }
+
+    State state() { return state_; }
+
+    Progress progress();
+
+protected:
+    bool copyTable(const Table &table, int shard);
+
+    // returns the rows still mismatched after fixing
+    unsigned long verifyTable(const Table &table, int shard);
+
+    // rows of the moved keyspace on the new owner `shard` but gone from the
+    // old owner are deleted, returns the rows deleted or failed
+    unsigned long verifyOrphans(const Table &table, int shard);
+
+    bool purgeTable(const Table &table, int shard);
+
+    // copies again the rows of the dual-writes failed since the last call
+    bool repairDualWrites();
+
+    // rows by shard key: REPLACEd on the new owner, deleted there if gone from the old one
+    bool repairKeys(const Table &table, const std::set<std::string> &keys);
+
+    typedef std::vector<mysqlpp::Row> Rows;
+
+    // keyset paging position in one shard
+    struct Cursor {
+        std::string last;
+        bool started = false;
+        bool done = false;
+    };
+
+    //
+    // next chunk of the shard, columns: `select` (all fields if empty)
+    //
+    bool readChunk(MySqlConnection *conn, const Table &table, Cursor &cursor,
+                   Rows &rows, const std::string &select = "");
+
+    bool readRowsByKeys(MySqlConnection *conn, const Table &table,
+                        const std::vector<std::string> &keys, Rows &rows,
+                        const std::string &select = "");
+
+    // the rows whose `column` is one of the keys
+    bool readRowsByColumn(MySqlConnection *conn, const Table &table, const std::string &column,
+                          const std::vector<std::string> &keys, Rows &rows,
+                          const std::string &select = "");
+
+    bool writeRows(int shard, const Table &table, const Rows &rows, bool replace);
+
+    bool deleteRows(MySqlConnection *conn, const Table &table, const std::vector<std::string> &keys);
+
+    std::string checksumColumn(const Table &table);
+
+    void throttle();
+
+private:
+    MySqlShardingPool *pool_;
+    int old_shardnum_;
+    int new_shardnum_;
+    std::vector<Table> tables_;
+
+    unsigned int chunk_size_ = 1000;
+    unsigned int chunk_interval_ = 10;
+    unsigned int verify_rounds_ = 3;
+    bool purge_ = true;
+
+    std::atomic<State> state_;
+    std::atomic<bool> stopping_;
+    std::thread thread_;
+
+    std::mutex mutex_;
+    Progress progress_;
+};
+
+#endif //TINYWORLD_TINYMYSQL_RESHARDING_H
@@ -0,0 +1,61 @@
+#ifndef TINYWORLD_TINYMYSQL_SEQUENCE_H
+#define TINYWORLD_TINYMYSQL_SEQUENCE_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include "tinymysql.h"
+#include "shardid.h"
+
+//
+// Hi/lo ID allocator over the per-shard sequence table:
+//
+//   MySqlSequence sequence("PLAYER");
+//   sequence.createTable();               // on every shard
+//
+//   uint64_t id = sequence.next(shard);   // shard embedded, see shardid.h
+//   uint64_t id = sequence.next();        // shards in round robin
+//
+// A block of IDs is reserved with one statement on the shard and then
+// handed out in memory, the IDs of an unfinished block are lost when the
+// process exits. Returns 0 if no block can be reserved.
+//
+class MySqlSequence {
+public:
+    MySqlSequence(const std::string &name,
+                  uint32_t block = 1000,
+                  MySqlShardingPool *pool = MySqlShardingPool::instance());
+
+    bool createTable();
+
+    uint64_t next(int shard);
+
+    uint64_t next();
+
+    static const char *tableName() { return "TINY_SEQUENCE"; }
+
+protected:
+    struct Block {
+        std::mutex mutex;
+        uint64_t next = 0;
+        uint64_t end = 0;
+    };
+
+    Block *block(int shard);
+
+    // [start, end) of a new block of the shard
+    bool reserve(int shard, uint64_t &start, uint64_t &end);
+
+private:
+    std::string name_;
+    uint32_t block_;
+    MySqlShardingPool *pool_;
+
+    std::mutex mutex_;
+    std::map<int, std::unique_ptr<Block>> blocks_;
+    std::atomic<uint32_t> round_;
+};
+
+#endif //TINYWORLD_TINYMYSQL_SEQUENCE_H
@@ -113,12 +113,29 @@ public:
 
     TableDescriptorBase &indexs(const std::initializer_list<std::string> &names);
 
+    //
+    // Sharding: the field hashed to route the record (TinyMySqlShardingORM),
+    // embedded: the field is an ID with the shard embedded (shardid.h)
+    //
+    TableDescriptorBase &shardKey(const std::string &name, bool embedded = false);
+
+    //
+    // Deadline(ms) of every statement on the table, 0: none
+    //
+    TableDescriptorBase &timeout(unsigned int ms);
+
     FieldDescriptor::Ptr getFieldDescriptor(const std::string &name);
 
     const FieldDescriptorList &fields() { return fields_ordered_; }
 
     const FieldDescriptorList &keys() { return keys_; }
 
+    FieldDescriptor::Ptr shardKey() { return shardkey_; }
+
+    bool shardKeyEmbedded() { return shardkey_embedded_; }
+
+    unsigned int timeout() { return timeout_; }
+
 public:
     TableDescriptorBase(const std::string name)
             : table(name) {}
@@ -129,6 +146,11 @@ public:
     FieldDescriptorList keys_;
     // Indexes
     FieldDescriptorList indexs_;
+    // Shard key
+    FieldDescriptor::Ptr shardkey_;
+    bool shardkey_embedded_ = false;
+    // Statement deadline(ms)
+    unsigned int timeout_ = 0;
     // Field Descriptors
     FieldDescriptorList fields_ordered_;
     // Field Descriptors by name
@@ -153,6 +175,41 @@ public:
         return *this;
     }
 
+    //
+    // Field's value as text (same as MySQL returns), for routing by shard key
+    //
+    std::string fieldToString(const T &obj, FieldDescriptor::Ptr fd) {
+        if (!fd) return "";
+
+        switch (fd->type) {
+            case FieldType::INT8   : return std::to_string((int) reflection.template get<int8_t>(obj, fd->name));
+            case FieldType::INT16  : return std::to_string(reflection.template get<int16_t>(obj, fd->name));
+            case FieldType::INT32  : return std::to_string(reflection.template get<int32_t>(obj, fd->name));
+            case FieldType::INT64  : return std::to_string(reflection.template get<int64_t>(obj, fd->name));
+            case FieldType::UINT8  : return std::to_string((int) reflection.template get<uint8_t>(obj, fd->name));
+            case FieldType::UINT16 : return std::to_string(reflection.template get<uint16_t>(obj, fd->name));
+            case FieldType::UINT32 : return std::to_string(reflection.template get<uint32_t>(obj, fd->name));
+            case FieldType::UINT64 : return std::to_string(reflection.template get<uint64_t>(obj, fd->name));
+            case FieldType::BOOL   : return reflection.template get<bool>(obj, fd->name) ? "1" : "0";
+            case FieldType::STRING :
+            case FieldType::VCHAR  :
+            case FieldType::BYTES  :
+            case FieldType::BYTES_TINY :
+            case FieldType::BYTES_MEDIUM :
+            case FieldType::BYTES_LONG :
+                return reflection.template get<std::string>(obj, fd->name);
+            default:
+                break;
+        }
+
+        // FLOAT/DOUBLE/OBJECT can't be a shard key
+        return "";
+    }
+
+    std::string shardKeyValue(const T &obj) {
+        return fieldToString(obj, shardkey_);
+    }
+
     Struct<T> reflection;
 };
 
@@ -36,13 +36,16 @@ public:
 
     //
     // 构造: 支持两种方式:
-    //   1. 连接池
+    //   1. 连接池(priority: 后台批量操作使用kPoolPriority_Low),
+    //      连接池配置了从库时, 读操作走从库(见MySqlConnectionPool::readPool)
     //   2. 指定连接
     //
-    TinyMySqlORM(MySqlConnectionPool *pool = &MySqlConnectionPool::instance()) {
+    TinyMySqlORM(MySqlConnectionPool *pool = &MySqlConnectionPool::instance(),
+                 PoolPriority priority = kPoolPriority_Normal) {
         if (pool) {
             pool_ = pool;
-            mysql_ = pool->grab();
+            priority_ = priority;
+            mysql_ = pool->grab(priority);
         }
     }
 
@@ -57,10 +60,28 @@ public:
     // 析构: 如果是用连接池初始化的则把连接放回
     //
     ~TinyMySqlORM() {
+        releaseReader();
         if (pool_)
             pool_->putback(mysql_);
     }
 
+    //
+    // 语句超时(ms, 0: 不限), 超时的语句被watchdog用KILL QUERY中断(见MySqlWatchdog),
+    // 操作返回false且timedOut()为true, 连接恢复可用:
+    //   setTimeout(ms)  - 本对象之后的所有操作
+    //   timeout(ms)     - 仅下一次操作: orm.timeout(200).loadFromDB<Player>(records, "...")
+    //   未指定时使用表的TableDescriptorBase::timeout(ms)
+    //
+    void setTimeout(unsigned int ms) { timeout_ = ms; }
+
+    TinyMySqlORM &timeout(unsigned int ms) {
+        next_timeout_ = ms;
+        return *this;
+    }
+
+    // 上一次操作是否因超时被中断
+    bool timedOut() const { return timedout_; }
+
     //
     // 更新所有表格的结构
     //
@@ -104,8 +125,20 @@ public:
     template<typename T>
     bool del(T &obj);
 
+    //
+    // 多行写入: 一条INSERT/REPLACE ... VALUES (...),(...)语句
+    //
+    template<typename T>
+    bool insertBatch(const std::vector<const T *> &objs);
+
+    template<typename T>
+    bool replaceBatch(const std::vector<const T *> &objs);
+
     //
     // 数据库批量加载
+    //   TINYSERIALIZER_DYN_REFLECTION=1时反序列化的临时消息分配在ProtoArena上:
+    //   调用者打开的ProtoArena::Scope, 否则使用线程自己的arena, 每行之后整体reset
+    //   (默认的ProtoDynSerializer直接读写wire, 不用arena)
     //
     template<typename T>
     using Records = std::vector<std::shared_ptr<T>>;
@@ -131,6 +164,22 @@ public:
     template<typename T>
     bool deleteFromDB(const char *where, ...);
 
+    //
+    // 数据库计数: SELECT COUNT(*) ... where
+    //
+    template<typename T>
+    bool countFromDB(uint64_t &count, const char *where, ...);
+
+    //
+    // 按字段值批量加载/删除: WHERE `field` IN (values...)
+    //
+    template<typename T>
+    bool loadFromDBByValues(const std::function<void(std::shared_ptr<T>)> &callback,
+                            const std::string &field, const std::vector<std::string> &values);
+
+    template<typename T>
+    bool deleteFromDBByValues(const std::string &field, const std::vector<std::string> &values);
+
 public:
     //
     // Generate SQL
@@ -150,6 +199,10 @@ public:
     template<typename T>
     bool makeDeleteQuery(mysqlpp::Query &query, const T &obj, TableDescriptor<T> *td = nullptr);
 
+    template<typename T>
+    bool makeBatchQuery(mysqlpp::Query &query, const char *verb, const std::vector<const T *> &objs,
+                        TableDescriptor<T> *td = nullptr);
+
 
 protected:
     bool updateExistTable(TableDescriptorBase* td);
@@ -181,10 +234,52 @@ protected:
     template<typename T>
     bool recordToObject(mysqlpp::Row &record, T &obj, TableDescriptor<T> *td);
 
+    template<typename T>
+    bool executeBatch(const char *verb, const std::vector<const T *> &objs);
+
+    void makeInList(mysqlpp::Query &query, const std::string &field, const std::vector<std::string> &values);
+
+    //
+    // connection for reading: a replica's if any, the primary's otherwise.
+    // Writing releases the replica's, so this object reads its own writes.
+    //
+    mysqlpp::Connection *reader();
+
+    mysqlpp::Connection *writer();
+
+    void releaseReader();
+
+    //
+    // deadline of the statement on conn, from construction to end() or
+    // destruction: end() it once the results are stored, before the rows
+    // are converted and handed to the callbacks
+    //
+    class Deadline {
+    public:
+        Deadline(TinyMySqlORM *orm, mysqlpp::Connection *conn, TableDescriptorBase *td);
+
+        ~Deadline();
+
+        void end();
+
+    private:
+        TinyMySqlORM *orm_;
+        mysqlpp::Connection *conn_;
+        uint64_t watch_ = 0;
+    };
+
 
 private:
     mysqlpp::Connection *mysql_ = nullptr;
     MySqlConnectionPool *pool_ = nullptr;
+    PoolPriority priority_ = kPoolPriority_Normal;
+
+    mysqlpp::Connection *reader_ = nullptr;
+    MySqlConnectionPool *reader_pool_ = nullptr;
+
+    unsigned int timeout_ = 0;
+    unsigned int next_timeout_ = 0;
+    bool timedout_ = false;
 };
 
 #include "tinyorm_mysql.in.h"
@@ -242,13 +242,16 @@ inline bool TinyMySqlORM::select(T &obj) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = reader();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         makeSelectQuery(query, obj, td);
         query << " LIMIT 1";
 
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
 
         mysqlpp::StoreQueryResult res = query.store();
+        deadline.end();
         if (res) {
             if (res.num_rows() == 1) {
                 return recordToObject(res[0], obj, td);
@@ -273,7 +276,9 @@ inline bool TinyMySqlORM::insert(T &obj) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         makeInsertQuery(query, obj, td);
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
         mysqlpp::SimpleResult res = query.execute();
@@ -300,7 +305,9 @@ inline bool TinyMySqlORM::replace(T &obj) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         makeReplaceQuery(query, obj, td);
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
         mysqlpp::SimpleResult res = query.execute();
@@ -316,6 +323,47 @@ inline bool TinyMySqlORM::replace(T &obj) {
     return false;
 }
 
+template<typename T>
+inline bool TinyMySqlORM::executeBatch(const char *verb, const std::vector<const T *> &objs) {
+
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return false;
+    }
+
+    if (objs.empty())
+        return true;
+
+    try {
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
+        makeBatchQuery(query, verb, objs, td);
+        LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
+        mysqlpp::SimpleResult res = query.execute();
+        if (res) {
+            return true;
+        }
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("TinyMySqlORM", "%s: %s", __PRETTY_FUNCTION__, err.what());
+        return false;
+    }
+
+    return false;
+}
+
+template<typename T>
+inline bool TinyMySqlORM::insertBatch(const std::vector<const T *> &objs) {
+    return executeBatch<T>("INSERT", objs);
+}
+
+template<typename T>
+inline bool TinyMySqlORM::replaceBatch(const std::vector<const T *> &objs) {
+    return executeBatch<T>("REPLACE", objs);
+}
+
 template<typename T>
 inline bool TinyMySqlORM::update(T &obj) {
 
@@ -326,7 +374,9 @@ inline bool TinyMySqlORM::update(T &obj) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         makeUpdateQuery(query, obj, td);
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
         mysqlpp::SimpleResult res = query.execute();
@@ -351,7 +401,9 @@ inline bool TinyMySqlORM::del(T &obj) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         makeDeleteQuery(query, obj, td);
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
         mysqlpp::SimpleResult res = query.execute();
@@ -382,14 +434,18 @@ TinyMySqlORM::vloadFromDB(const std::function<void(std::shared_ptr<T>)> &callbac
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = reader();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         query << "SELECT " << td->sql_fieldlist();
         query << " FROM `" << td->table << "` ";
         query << statement;
 
         LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
         mysqlpp::StoreQueryResult res = query.store();
+        deadline.end();
         if (res) {
+            ProtoLoadBatch batch;
             for (size_t i = 0; i < res.num_rows(); ++i) {
                 std::shared_ptr<T> obj = std::make_shared<T>();
                 if (recordToObject(res[i], *obj.get(), td)) {
@@ -397,6 +453,7 @@ TinyMySqlORM::vloadFromDB(const std::function<void(std::shared_ptr<T>)> &callbac
                 } else {
                     LOG_ERROR("TinyMySqlORM", "%s: recordToObject FAILED", __PRETTY_FUNCTION__);
                 }
+                batch.next();
             }
             return true;
         }
@@ -477,7 +534,9 @@ inline bool TinyMySqlORM::deleteFromDB(const char *where, ...) {
     }
 
     try {
-        mysqlpp::Query query = mysql_->query();
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
         query << "DELETE FROM `" << td->table << "` ";
         query << statement;
 
@@ -496,6 +555,205 @@ inline bool TinyMySqlORM::deleteFromDB(const char *where, ...) {
     return false;
 }
 
+template<typename T>
+inline bool TinyMySqlORM::countFromDB(uint64_t &count, const char *where, ...) {
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return false;
+    }
+
+    char statement[1024] = "";
+    if (where) {
+        va_list ap;
+        va_start(ap, where);
+        vsnprintf(statement, sizeof(statement), where, ap);
+        va_end(ap);
+    }
+
+    try {
+        mysqlpp::Connection *conn = reader();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
+        query << "SELECT COUNT(*) FROM `" << td->table << "` ";
+        query << statement;
+
+        LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
+        mysqlpp::StoreQueryResult res = query.store();
+        deadline.end();
+        if (res && res.num_rows() > 0) {
+            count = res[0][0];
+            return true;
+        }
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("TinyMySqlORM", "%s: %s", __PRETTY_FUNCTION__, err.what());
+        return false;
+    }
+
+    return false;
+}
+
+template<typename T>
+inline bool TinyMySqlORM::loadFromDBByValues(const std::function<void(std::shared_ptr<T>)> &callback,
+                                             const std::string &field, const std::vector<std::string> &values) {
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return false;
+    }
+
+    if (values.empty())
+        return true;
+
+    try {
+        mysqlpp::Connection *conn = reader();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
+        query << "SELECT " << td->sql_fieldlist();
+        query << " FROM `" << td->table << "` WHERE ";
+        makeInList(query, field, values);
+
+        LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
+        mysqlpp::StoreQueryResult res = query.store();
+        deadline.end();
+        if (res) {
+            ProtoLoadBatch batch;
+            for (size_t i = 0; i < res.num_rows(); ++i) {
+                std::shared_ptr<T> obj = std::make_shared<T>();
+                if (recordToObject(res[i], *obj.get(), td)) {
+                    callback(obj);
+                } else {
+                    LOG_ERROR("TinyMySqlORM", "%s: recordToObject FAILED", __PRETTY_FUNCTION__);
+                }
+                batch.next();
+            }
+            return true;
+        }
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("TinyMySqlORM", "%s: %s", __PRETTY_FUNCTION__, err.what());
+        return false;
+    }
+
+    return false;
+}
+
+template<typename T>
+inline bool TinyMySqlORM::deleteFromDBByValues(const std::string &field, const std::vector<std::string> &values) {
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return false;
+    }
+
+    if (values.empty())
+        return true;
+
+    try {
+        mysqlpp::Connection *conn = writer();
+        Deadline deadline(this, conn, td);
+        mysqlpp::Query query = conn->query();
+        query << "DELETE FROM `" << td->table << "` WHERE ";
+        makeInList(query, field, values);
+
+        LOG_TRACE("TinyMySqlORM", "%s", query.str().c_str());
+        mysqlpp::SimpleResult res = query.execute();
+        if (res) {
+            return true;
+        }
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("TinyMySqlORM", "%s: %s", __PRETTY_FUNCTION__, err.what());
+        return false;
+    }
+
+    return false;
+}
+
+inline void
+TinyMySqlORM::makeInList(mysqlpp::Query &query, const std::string &field, const std::vector<std::string> &values) {
+    query << "`" << field << "` IN (";
+    for (size_t i = 0; i < values.size(); ++i) {
+        query << mysqlpp::quote << values[i];
+        if (i != values.size() - 1) {
+            query << ",";
+        }
+    }
+    query << ")";
+}
+
+
+inline mysqlpp::Connection *TinyMySqlORM::reader() {
+    if (reader_)
+        return reader_;
+
+    if (!pool_ || !pool_->replicaCount())
+        return mysql_;
+
+    MySqlConnectionPool *pool = pool_->readPool();
+    if (pool == pool_)
+        return mysql_;
+
+    reader_ = pool->acquire(priority_);
+    if (!reader_)
+        return mysql_;
+
+    reader_pool_ = pool;
+    return reader_;
+}
+
+inline mysqlpp::Connection *TinyMySqlORM::writer() {
+    if (pool_) {
+        releaseReader();
+        pool_->markWritten();
+    }
+    return mysql_;
+}
+
+inline void TinyMySqlORM::releaseReader() {
+    if (reader_pool_ && reader_)
+        reader_pool_->putback(reader_);
+
+    reader_ = nullptr;
+    reader_pool_ = nullptr;
+}
+
+inline TinyMySqlORM::Deadline::Deadline(TinyMySqlORM *orm, mysqlpp::Connection *conn, TableDescriptorBase *td)
+        : orm_(orm), conn_(conn) {
+    unsigned int ms = orm->next_timeout_ ? orm->next_timeout_ : orm->timeout_;
+    if (!ms && td)
+        ms = td->timeout();
+
+    orm->next_timeout_ = 0;
+    orm->timedout_ = false;
+
+    if (ms)
+        watch_ = MySqlWatchdog::instance().watch(dynamic_cast<MySqlConnection *>(conn), ms);
+}
+
+inline TinyMySqlORM::Deadline::~Deadline() {
+    end();
+}
+
+inline void TinyMySqlORM::Deadline::end() {
+    uint64_t watch = watch_;
+    watch_ = 0;
+    if (!MySqlWatchdog::instance().unwatch(watch))
+        return;
+
+    orm_->timedout_ = true;
+    LOG_WARN("TinyMySqlORM", "statement timed out, killed");
+
+    // the KILL may have arrived after the statement finished, a
+    // statement-less round trip absorbs it before the connection is reused
+    try {
+        mysqlpp::Query query = conn_->query();
+        query.exec("DO 0");
+    }
+    catch (std::exception &) {
+    }
+}
 
 template<typename T>
 inline void
@@ -736,7 +994,7 @@ inline bool TinyMySqlORM::recordToObject(mysqlpp::Row &record, T &obj, TableDesc
                     break;
                 }
 
-                if (!prop->deserialize(obj, std::string(record[i].data(), record[i].size()))) {
+                if (!prop->deserialize(obj, record[i].data(), record[i].size())) {
                     ret = false;
                     LOG_ERROR("TinyMySqlORM", "%s.%s Property deserialize failed", td->table.c_str(), fd->name.c_str());
                     break;
@@ -790,6 +1048,28 @@ inline bool TinyMySqlORM::makeReplaceQuery(mysqlpp::Query &query, const T &obj,
     return true;
 }
 
+template<typename T>
+inline bool TinyMySqlORM::makeBatchQuery(mysqlpp::Query &query, const char *verb, const std::vector<const T *> &objs,
+                                         TableDescriptor<T> *td) {
+    if (!td) td = TableFactory::instance().tableByType<T>();
+    if (!td || objs.empty()) return false;
+
+    query << verb << " INTO `" << td->table
+          << "`(" << td->sql_fieldlist() << ")"
+          << " VALUES ";
+    for (size_t i = 0; i < objs.size(); ++i) {
+        query << "(";
+        makeValueList(query, const_cast<T &>(*objs[i]), td, td->fields());
+        query << ")";
+
+        if (i != objs.size() - 1) {
+            query << ",";
+        }
+    }
+
+    return true;
+}
+
 template<typename T>
 inline bool TinyMySqlORM::makeUpdateQuery(mysqlpp::Query &query, const T &obj, TableDescriptor<T> *td) {
     if (!td) td = TableFactory::instance().tableByType<T>();
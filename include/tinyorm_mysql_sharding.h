@@ -0,0 +1,1152 @@
+#ifndef TINYWORLD_TINYORM_MYSQL_SHARDING_H
+#define TINYWORLD_TINYORM_MYSQL_SHARDING_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdlib>
+#include <functional>
+#include "tinyorm_mysql.h"
+#include "workers.h"
+#include "gather.h"
+#include "shardbatch.h"
+
+//
+// ORM over MySqlShardingPool, every record is routed by its table's shard key:
+//
+//   TableFactory::instance().table<Player>("PLAYER")
+//           .field(&Player::id, "ID", FieldType::UINT32)
+//           ...
+//           .key("ID")
+//           .shardKey("ID");
+//
+//   TinyMySqlShardingORM orm;
+//   orm.select(player);          // reads from the owner of player.id
+//   orm.replace(player);         // writes to the owner (and the new owner while resharding)
+//
+// During a migration window (MySqlResharding) the writes go to both owners,
+// the new owner always gets a REPLACE (DELETE for del) so it converges no
+// matter whether the row has been copied yet. The result is the old owner's,
+// a failed write to the new owner is recorded in the pool and repaired by
+// the resharding before it switches.
+//
+// Reads (select, loadByKeys, loadFromAllShards...) go to the shard's
+// replicas when its URL lists some, except right after this thread wrote
+// to the shard (read-your-writes window, see MySqlConnectionPool). With
+// hedge=1 a read slower than the replica's p95 goes to a second replica.
+//
+// Every request to a host goes through the host's circuit breaker and
+// fails fast while the host keeps failing.
+//
+// Every request to a shard and every key routed are counted in the
+// pool's ShardingStats: pool->stats().shards(), pool->stats().hotKeys().
+//
+class TinyMySqlShardingORM {
+public:
+    typedef MySqlShardingPool PoolType;
+
+    template<typename T>
+    using Records = std::vector<std::shared_ptr<T>>;
+
+    TinyMySqlShardingORM(MySqlShardingPool *pool = MySqlShardingPool::instance(),
+                         PoolPriority priority = kPoolPriority_Normal)
+            : pool_(pool), priority_(priority) {}
+
+    //
+    // 在所有分片上创建、删除、自动更新表结构
+    //
+    template<typename T>
+    bool createTableByType();
+
+    template<typename T>
+    bool dropTableByType();
+
+    template<typename T>
+    bool updateTableByType();
+
+    //
+    // 针对某个对象的数据库操作, 按分片键路由
+    //
+    template<typename T>
+    bool select(T &obj);
+
+    template<typename T>
+    bool insert(T &obj);
+
+    template<typename T>
+    bool replace(T &obj);
+
+    template<typename T>
+    bool update(T &obj);
+
+    template<typename T>
+    bool del(T &obj);
+
+    //
+    // 按分片键值批量加载/删除, 自动按分片分组, 每个分片一条语句
+    //
+    template<typename T>
+    bool loadByKeys(Records<T> &records, const std::vector<std::string> &keys);
+
+    template<typename T>
+    bool loadByKeys(const std::function<void(std::shared_ptr<T>)> &callback, const std::vector<std::string> &keys);
+
+    template<typename T>
+    bool deleteByKeys(const std::vector<std::string> &keys);
+
+    //
+    // Scatter-gather: the query is sent to every shard concurrently and the
+    // results are merged, so the latency is the slowest shard's. Returns
+    // true if every shard answered.
+    //
+    //   TinyMySqlShardingORM::GatherOptions<Player> options;
+    //   options.less = [](const Player &a, const Player &b) { return a.age > b.age; };
+    //   options.limit = 100;
+    //   options.timeout = 200;
+    //   orm.loadFromAllShards(records, options, &result, "WHERE LOGIN>%u ORDER BY AGE DESC", time);
+    //
+    struct GatherResult {
+        int shards = 0;
+        int succeeded = 0;
+        int failed = 0;
+        int timedout = 0;
+
+        bool complete() const { return succeeded == shards; }
+    };
+
+    template<typename T>
+    struct GatherOptions {
+        // k-way merge by this order, every shard must return its rows in
+        // the same order (ORDER BY in the clause)
+        std::function<bool(const T &, const T &)> less;
+        // global LIMIT, also appended to every shard's query unless the
+        // clause has a LIMIT of its own (then it must not be lower)
+        size_t limit = 0;
+        // ms to wait for the shards, 0: wait for all. The results of the
+        // shards not answered in time are dropped (partial results)
+        unsigned int timeout = 0;
+    };
+
+    template<typename T>
+    bool loadFromAllShards(Records<T> &records, const char *clause, ...);
+
+    template<typename T>
+    bool loadFromAllShards(Records<T> &records, const GatherOptions<T> &options, GatherResult *result,
+                           const char *clause, ...);
+
+    // counted by every shard: stale copies of a migration not purged yet count too
+    template<typename T>
+    bool countFromAllShards(uint64_t &count, const char *where, ...);
+
+    template<typename T>
+    bool countFromAllShards(uint64_t &count, unsigned int timeout, GatherResult *result, const char *where, ...);
+
+    //
+    // Batch writes: the objects are partitioned by shard, every partition
+    // is written with multi-row statements on its own shard connection,
+    // all the shards in parallel. A failed statement is retried, returns
+    // true if every object has been written to its owner.
+    //
+    //   std::vector<TinyMySqlShardingORM::BatchResult> results;
+    //   orm.replaceBatch(players, &results);
+    //
+    struct BatchResult {
+        int shard = -1;
+        size_t rows = 0;     // rows written
+        size_t failed = 0;   // rows not written after all the retries
+        int attempts = 0;
+    };
+
+    void setBatchRows(size_t rows) { batch_rows_ = rows; }
+
+    void setBatchRetries(unsigned int retries) { batch_retries_ = retries; }
+
+    template<typename T>
+    bool insertBatch(const Records<T> &records, std::vector<BatchResult> *results = nullptr);
+
+    template<typename T>
+    bool insertBatch(const std::vector<T> &objs, std::vector<BatchResult> *results = nullptr);
+
+    template<typename T>
+    bool replaceBatch(const Records<T> &records, std::vector<BatchResult> *results = nullptr);
+
+    template<typename T>
+    bool replaceBatch(const std::vector<T> &objs, std::vector<BatchResult> *results = nullptr);
+
+protected:
+    typedef std::map<int, std::vector<std::string>> KeysByShard;
+
+    template<typename T>
+    TableDescriptor<T> *shardedTable();
+
+    //
+    // shard id by the shard key's value: decoded from an embedded ID
+    // (shardid.h), or hashed. Writes go to 2 shards while migrating.
+    //
+    int readShardID(TableDescriptorBase *td, const std::string &key);
+
+    static int readShardID(MySqlShardingPool *pool, TableDescriptorBase *td, const std::string &key);
+
+    int writeShardIDs(TableDescriptorBase *td, const std::string &key, int ids[2]);
+
+    // read-your-writes: the calling thread reads the shard from its primary for a while
+    void markWritten(int shard);
+
+    MySqlConnectionPool *shardPool(int shard);
+
+    // op of a request to the shard, timed into the pool's ShardingStats
+    static bool measure(MySqlShardingPool *pool, int shard, const std::function<bool()> &op);
+
+    void touch(int shard, const std::string &key) {
+        if (pool_) pool_->stats().touch(shard, key);
+    }
+
+    //
+    // op on a connection of the pool, guarded by the pool's circuit breaker
+    // (fails fast while open), the latency is recorded. Errors of the
+    // connection and timeouts count as failures, "not found" does not.
+    //
+    static bool runOnPool(MySqlConnectionPool *pool, PoolPriority priority,
+                          const std::function<bool(TinyMySqlORM &)> &op);
+
+    //
+    // idempotent read on the shard's replicas: if the first replica has
+    // not answered after its p95 latency, the read is sent to a second
+    // one and the first answer wins. value is the prototype and result.
+    // Both run on hedgeWorkers(), no hedging while all of them are busy.
+    //
+    template<typename R>
+    static bool readHedged(MySqlConnectionPool *primary, PoolPriority priority,
+                           const std::function<bool(TinyMySqlORM &, R &)> &op, R &value);
+
+    enum { kHedgeWorkers = 16 };
+
+    static WorkerPool &hedgeWorkers() {
+        static WorkerPool workers(kHedgeWorkers);
+        return workers;
+    }
+
+    // the scatter-gather fan-out, queued when all busy
+    enum { kScatterWorkers = 32 };
+
+    static WorkerPool &scatterWorkers() {
+        static WorkerPool workers(kScatterWorkers);
+        return workers;
+    }
+
+    //
+    // op(orm, first): first is true for the current owner
+    //
+    template<typename T>
+    bool write(T &obj, const std::function<bool(TinyMySqlORM &, bool)> &op);
+
+    bool forEachShard(const std::function<bool(TinyMySqlORM &)> &op);
+
+    //
+    // run op(orm, shard, value) on every shard of the list on scatterWorkers(),
+    // done[i]: 1 succeeded, -1 failed, 0 not answered in time. A slow shard
+    // finishes in background and its value is dropped, the ones not started
+    // yet are skipped (timeout 0 waits for all). read: a replica may serve
+    // it, unless the calling thread wrote to the shard recently.
+    //
+    template<typename R>
+    void scatterTo(const std::vector<int> &shards, const std::function<bool(TinyMySqlORM &, int, R &)> &op,
+                   unsigned int timeout, std::vector<R> &values, std::vector<int> &done, bool read);
+
+    //
+    // run op(orm, shard, value) on all the shards, results of the shards
+    // answered in time
+    //
+    template<typename R>
+    bool scatter(const std::function<bool(TinyMySqlORM &, int, R &)> &op, unsigned int timeout,
+                 std::vector<R> &results, GatherResult *result);
+
+    template<typename T>
+    bool writeBatch(const std::vector<const T *> &objs, bool replace, std::vector<BatchResult> *results);
+
+    template<typename T>
+    bool vloadFromAllShards(Records<T> &records, const GatherOptions<T> &options, GatherResult *result,
+                            const char *clause, va_list ap);
+
+    template<typename T>
+    bool vcountFromAllShards(uint64_t &count, unsigned int timeout, GatherResult *result,
+                             const char *where, va_list ap);
+
+    template<typename T>
+    static void mergeSorted(std::vector<Records<T>> &parts, const std::function<bool(const T &, const T &)> &less,
+                            size_t limit, Records<T> &records);
+
+private:
+    MySqlShardingPool *pool_;
+    PoolPriority priority_;
+
+    // rows per multi-row statement (max_allowed_packet) and retries of a failed one
+    size_t batch_rows_ = 500;
+    unsigned int batch_retries_ = 2;
+};
+
+template<typename T>
+inline TableDescriptor<T> *TinyMySqlShardingORM::shardedTable() {
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return nullptr;
+    }
+
+    if (!td->shardKey()) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table %s has no shard key", __PRETTY_FUNCTION__, td->table.c_str());
+        return nullptr;
+    }
+
+    return td;
+}
+
+inline int TinyMySqlShardingORM::readShardID(TableDescriptorBase *td, const std::string &key) {
+    return readShardID(pool_, td, key);
+}
+
+inline int TinyMySqlShardingORM::readShardID(MySqlShardingPool *pool, TableDescriptorBase *td,
+                                             const std::string &key) {
+    if (td->shardKeyEmbedded())
+        return pool->shardIDByEmbeddedID(strtoull(key.c_str(), NULL, 10));
+    return pool->shardIDByKey(key);
+}
+
+inline int TinyMySqlShardingORM::writeShardIDs(TableDescriptorBase *td, const std::string &key, int ids[2]) {
+    if (td->shardKeyEmbedded()) {
+        ids[0] = readShardID(td, key);
+        return 1;
+    }
+    return pool_->writeShardIDsByKey(key, ids);
+}
+
+inline void TinyMySqlShardingORM::markWritten(int shard) {
+    MySqlConnectionPool *pool = pool_->getShardByID(shard);
+    if (pool)
+        pool->markWritten();
+}
+
+inline MySqlConnectionPool *TinyMySqlShardingORM::shardPool(int shard) {
+    MySqlConnectionPool *pool = pool_ ? pool_->getShardByID(shard) : nullptr;
+    if (!pool)
+        LOG_ERROR("TinyMySqlORM", "%s: Shard %d is not available", __PRETTY_FUNCTION__, shard);
+    return pool;
+}
+
+inline bool TinyMySqlShardingORM::measure(MySqlShardingPool *pool, int shard, const std::function<bool()> &op) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = op();
+    if (pool) {
+        pool->stats().record(shard, std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count(), ok);
+    }
+    return ok;
+}
+
+inline bool TinyMySqlShardingORM::runOnPool(MySqlConnectionPool *pool, PoolPriority priority,
+                                            const std::function<bool(TinyMySqlORM &)> &op) {
+    if (!pool) return false;
+
+    if (!pool->breaker().allow()) {
+        LOG_WARN("TinyMySqlORM", "%s: %s circuit breaker is open", __PRETTY_FUNCTION__, pool->url().c_str());
+        return false;
+    }
+
+    // a failure if op throws
+    CircuitBreaker::Guard outcome(pool->breaker());
+    auto start = std::chrono::steady_clock::now();
+
+    ScopedMySqlConnection conn(priority, pool);
+    if (!conn) {
+        outcome.failure();
+        return false;
+    }
+
+    TinyMySqlORM orm(&*conn);
+    bool ok = op(orm);
+    if (ok || (!conn->errnum() && !orm.timedOut())) {
+        outcome.success();
+        pool->latency().record(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count());
+    } else {
+        outcome.failure();
+    }
+
+    return ok;
+}
+
+template<typename R>
+inline bool TinyMySqlShardingORM::readHedged(MySqlConnectionPool *primary, PoolPriority priority,
+                                             const std::function<bool(TinyMySqlORM &, R &)> &op, R &value) {
+    if (!primary) return false;
+
+    std::vector<MySqlConnectionPool *> pools = primary->readPools(2);
+    if (!primary->hedgedReads() || pools.size() < 2) {
+        return runOnPool(pools[0], priority, [&op, &value](TinyMySqlORM &orm) {
+            return op(orm, value);
+        });
+    }
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cond;
+        R prototype;
+        R value;
+        bool won = false;
+        int finished = 0;
+    };
+
+    auto state = std::make_shared<State>();
+    state->prototype = value;
+
+    auto launch = [state, op, priority](MySqlConnectionPool *pool) {
+        return hedgeWorkers().tryPost([state, op, priority, pool]() {
+            R result = state->prototype;
+            bool ok = false;
+            try {
+                ok = runOnPool(pool, priority, [&op, &result](TinyMySqlORM &orm) {
+                    return op(orm, result);
+                });
+            }
+            catch (std::exception &err) {
+                LOG_ERROR("TinyMySqlORM", "readHedged: %s, %s", pool->url().c_str(), err.what());
+            }
+
+            std::lock_guard<std::mutex> guard(state->mutex);
+            state->finished++;
+            if (ok && !state->won) {
+                state->won = true;
+                state->value = std::move(result);
+            }
+            state->cond.notify_all();
+        });
+    };
+
+    // all the workers busy: not hedged
+    if (!launch(pools[0])) {
+        return runOnPool(pools[0], priority, [&op, &value](TinyMySqlORM &orm) {
+            return op(orm, value);
+        });
+    }
+
+    // p95 of the first replica, 10ms until it has enough samples
+    uint64_t delay = 10000;
+    if (pools[0]->latency().count() >= 20)
+        delay = std::max<uint64_t>(pools[0]->latency().percentile(95), 1000);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cond.wait_for(lock, std::chrono::microseconds(delay), [&state]() { return state->finished > 0; });
+
+    int launched = 1;
+    if (!state->finished) {
+        lock.unlock();
+        if (launch(pools[1]))
+            launched++;
+        lock.lock();
+    }
+
+    state->cond.wait(lock, [&state, launched]() { return state->won || state->finished == launched; });
+    if (state->won) {
+        value = std::move(state->value);
+        return true;
+    }
+
+    return false;
+}
+
+inline bool TinyMySqlShardingORM::forEachShard(const std::function<bool(TinyMySqlORM &)> &op) {
+    if (!pool_) return false;
+
+    bool ok = true;
+    int shardnum = pool_->shardNum();
+    for (int shard = 0; shard < shardnum; ++shard) {
+        if (!runOnPool(shardPool(shard), priority_, op))
+            ok = false;
+    }
+    return ok;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::createTableByType() {
+    return forEachShard([](TinyMySqlORM &orm) { return orm.createTableByType<T>(); });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::dropTableByType() {
+    return forEachShard([](TinyMySqlORM &orm) { return orm.dropTableByType<T>(); });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::updateTableByType() {
+    return forEachShard([](TinyMySqlORM &orm) { return orm.updateTableByType<T>(); });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::select(T &obj) {
+    auto td = shardedTable<T>();
+    if (!td || !pool_)
+        return false;
+
+    std::string key = td->shardKeyValue(obj);
+    int shard = readShardID(td, key);
+    touch(shard, key);
+
+    return measure(pool_, shard, [this, shard, &obj]() {
+        return readHedged<T>(shardPool(shard), priority_, [](TinyMySqlORM &orm, T &result) {
+            return orm.select(result);
+        }, obj);
+    });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::write(T &obj, const std::function<bool(TinyMySqlORM &, bool)> &op) {
+    auto td = shardedTable<T>();
+    if (!td || !pool_)
+        return false;
+
+    int ids[2];
+    std::string key = td->shardKeyValue(obj);
+    int count = writeShardIDs(td, key, ids);
+    touch(ids[0], key);
+
+    bool ret = false;
+    for (int i = 0; i < count; ++i) {
+        markWritten(ids[i]);
+
+        bool first = (i == 0);
+        int shard = ids[i];
+        bool ok = measure(pool_, shard, [this, shard, &op, first]() {
+            return runOnPool(shardPool(shard), priority_, [&op, first](TinyMySqlORM &orm) {
+                return op(orm, first);
+            });
+        });
+        if (i == 0) {
+            ret = ok;
+        } else if (!ok) {
+            LOG_ERROR("TinyMySqlORM", "%s: Dual-write to shard %d FAILED, key=%s",
+                      __PRETTY_FUNCTION__, ids[i], key.c_str());
+            pool_->dualWriteFailed(td->table, key);
+        }
+    }
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::insert(T &obj) {
+    return write(obj, [&obj](TinyMySqlORM &orm, bool first) {
+        return first ? orm.insert(obj) : orm.replace(obj);
+    });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::replace(T &obj) {
+    return write(obj, [&obj](TinyMySqlORM &orm, bool) {
+        return orm.replace(obj);
+    });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::update(T &obj) {
+    return write(obj, [&obj](TinyMySqlORM &orm, bool first) {
+        return first ? orm.update(obj) : orm.replace(obj);
+    });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::del(T &obj) {
+    return write(obj, [&obj](TinyMySqlORM &orm, bool) {
+        return orm.del(obj);
+    });
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::loadByKeys(Records<T> &records, const std::vector<std::string> &keys) {
+    return loadByKeys<T>([&records](std::shared_ptr<T> obj) {
+        records.push_back(obj);
+    }, keys);
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::loadByKeys(const std::function<void(std::shared_ptr<T>)> &callback,
+                                             const std::vector<std::string> &keys) {
+    auto td = shardedTable<T>();
+    if (!td || !pool_) return false;
+
+    KeysByShard groups;
+    for (auto &key : keys) {
+        int shard = readShardID(td, key);
+        touch(shard, key);
+        groups[shard].push_back(key);
+    }
+
+    bool ok = true;
+    std::string field = td->shardKey()->name;
+    for (auto &group : groups) {
+        const std::vector<std::string> &values = group.second;
+        Records<T> records;
+        int shard = group.first;
+        bool loaded = measure(pool_, shard, [this, shard, &field, &values, &records]() {
+            return readHedged<Records<T>>(shardPool(shard), priority_,
+                                          [field, values](TinyMySqlORM &orm, Records<T> &result) {
+                return orm.loadFromDBByValues<T>([&result](std::shared_ptr<T> obj) {
+                    result.push_back(obj);
+                }, field, values);
+            }, records);
+        });
+
+        if (!loaded) {
+            ok = false;
+            continue;
+        }
+
+        for (auto &record : records)
+            callback(record);
+    }
+    return ok;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::deleteByKeys(const std::vector<std::string> &keys) {
+    auto td = shardedTable<T>();
+    if (!td || !pool_) return false;
+
+    // the owners' groups, then the new owners' (dual-writes)
+    KeysByShard groups[2];
+    for (auto &key : keys) {
+        int ids[2];
+        int count = writeShardIDs(td, key, ids);
+        touch(ids[0], key);
+        for (int i = 0; i < count; ++i)
+            groups[i][ids[i]].push_back(key);
+    }
+
+    bool ok = true;
+    std::string field = td->shardKey()->name;
+    for (int i = 0; i < 2; ++i) {
+        for (auto &group : groups[i]) {
+            markWritten(group.first);
+
+            const std::vector<std::string> &values = group.second;
+            int shard = group.first;
+            if (measure(pool_, shard, [this, shard, &field, &values]() {
+                return runOnPool(shardPool(shard), priority_, [&field, &values](TinyMySqlORM &orm) {
+                    return orm.deleteFromDBByValues<T>(field, values);
+                });
+            }))
+                continue;
+
+            if (i == 0) {
+                ok = false;
+            } else {
+                LOG_ERROR("TinyMySqlORM", "%s: Dual-write to shard %d, %zu keys FAILED", __PRETTY_FUNCTION__,
+                          shard, values.size());
+                for (auto &key : values)
+                    pool_->dualWriteFailed(td->table, key);
+            }
+        }
+    }
+    return ok;
+}
+
+template<typename R>
+inline void TinyMySqlShardingORM::scatterTo(const std::vector<int> &shards,
+                                            const std::function<bool(TinyMySqlORM &, int, R &)> &op,
+                                            unsigned int timeout, std::vector<R> &values, std::vector<int> &done,
+                                            bool read) {
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<R> values;
+        std::vector<int> done;
+        size_t pending = 0;
+        bool abandoned = false;
+    };
+
+    auto state = std::make_shared<State>();
+    state->values.resize(shards.size());
+    state->done.resize(shards.size(), 0);
+    state->pending = shards.size();
+
+    MySqlShardingPool *pool = pool_;
+    PoolPriority priority = priority_;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        int shard = shards[i];
+        MySqlConnectionPool *primary = pool ? pool->getShardByID(shard) : nullptr;
+
+        // read-your-writes is the calling thread's, not the worker's
+        bool replica = read && primary && !primary->recentlyWritten();
+
+        bool posted = scatterWorkers().post([state, op, pool, primary, priority, shard, i, replica]() {
+            {
+                // the caller gave up before this one started
+                std::lock_guard<std::mutex> guard(state->mutex);
+                if (state->abandoned)
+                    return;
+            }
+
+            R value = R();
+            bool ok = false;
+            try {
+                ok = measure(pool, shard, [&]() {
+                    if (primary && replica) {
+                        return readHedged<R>(primary, priority, [op, shard](TinyMySqlORM &orm, R &result) {
+                            return op(orm, shard, result);
+                        }, value);
+                    } else if (primary) {
+                        return runOnPool(primary, priority, [&op, shard, &value](TinyMySqlORM &orm) {
+                            return op(orm, shard, value);
+                        });
+                    }
+                    return false;
+                });
+            }
+            catch (std::exception &err) {
+                LOG_ERROR("TinyMySqlORM", "scatterTo: Shard %d, %s", shard, err.what());
+            }
+
+            std::lock_guard<std::mutex> guard(state->mutex);
+            state->values[i] = std::move(value);
+            state->done[i] = ok ? 1 : -1;
+            if (--state->pending == 0)
+                state->cond.notify_all();
+        });
+
+        if (!posted) {
+            LOG_ERROR("TinyMySqlORM", "%s: Shard %d, workers stopped", __PRETTY_FUNCTION__, shard);
+            std::lock_guard<std::mutex> guard(state->mutex);
+            state->done[i] = -1;
+            --state->pending;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (timeout) {
+        state->cond.wait_for(lock, std::chrono::milliseconds(timeout), [&state]() { return state->pending == 0; });
+    } else {
+        state->cond.wait(lock, [&state]() { return state->pending == 0; });
+    }
+    state->abandoned = true;
+
+    values.resize(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (state->done[i] != 0)
+            values[i] = std::move(state->values[i]);
+    }
+    done = state->done;
+}
+
+template<typename R>
+inline bool TinyMySqlShardingORM::scatter(const std::function<bool(TinyMySqlORM &, int, R &)> &op,
+                                          unsigned int timeout, std::vector<R> &results, GatherResult *result) {
+    GatherResult gather;
+    results.clear();
+
+    std::vector<int> shards;
+    int shardnum = pool_ ? pool_->shardNum() : 0;
+    for (int shard = 0; shard < shardnum; ++shard)
+        shards.push_back(shard);
+    gather.shards = shardnum;
+
+    std::vector<R> values;
+    std::vector<int> done;
+    scatterTo<R>(shards, op, timeout, values, done, true);
+
+    for (size_t i = 0; i < shards.size(); ++i) {
+        if (done[i] == 1) {
+            results.push_back(std::move(values[i]));
+            gather.succeeded++;
+        } else if (done[i] == -1) {
+            LOG_ERROR("TinyMySqlORM", "%s: Shard %d FAILED", __PRETTY_FUNCTION__, shards[i]);
+            gather.failed++;
+        } else {
+            LOG_WARN("TinyMySqlORM", "%s: Shard %d timed out after %u ms", __PRETTY_FUNCTION__, shards[i], timeout);
+            gather.timedout++;
+        }
+    }
+
+    if (result)
+        *result = gather;
+    return gather.complete();
+}
+
+template<typename T>
+inline void TinyMySqlShardingORM::mergeSorted(std::vector<Records<T>> &parts,
+                                              const std::function<bool(const T &, const T &)> &less,
+                                              size_t limit, Records<T> &records) {
+    gather_merge_sorted<T>(parts, less, limit, records);
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::vloadFromAllShards(Records<T> &records, const GatherOptions<T> &options,
+                                                     GatherResult *result, const char *clause, va_list ap) {
+    auto td = TableFactory::instance().tableByType<T>();
+    if (!td) {
+        LOG_ERROR("TinyMySqlORM", "%s: Table descriptor is not exist", __PRETTY_FUNCTION__);
+        return false;
+    }
+
+    char statement[1024] = "";
+    if (clause) {
+        int length = vsnprintf(statement, sizeof(statement), clause, ap);
+        if (length < 0 || (size_t) length >= sizeof(statement)) {
+            LOG_ERROR("TinyMySqlORM", "%s: Statement too long: %s", __PRETTY_FUNCTION__, clause);
+            return false;
+        }
+    }
+
+    // a LIMIT of the caller's is kept, options.limit is still the global one
+    std::string sql = statement;
+    if (options.limit && !gather_has_limit(sql))
+        sql += " LIMIT " + std::to_string(options.limit);
+
+    // formatted again by every shard's loadFromDB
+    if (sql.size() >= sizeof(statement)) {
+        LOG_ERROR("TinyMySqlORM", "%s: Statement too long: %s", __PRETTY_FUNCTION__, sql.c_str());
+        return false;
+    }
+
+    //
+    // a row the shard doesn't own is a stale copy of a migration not purged
+    // yet (MySqlResharding), its owner returns it
+    //
+    MySqlShardingPool *pool = pool_;
+    std::vector<Records<T>> parts;
+    bool ret = scatter<Records<T>>([sql, pool, td](TinyMySqlORM &orm, int shard, Records<T> &part) {
+        if (!orm.loadFromDB<T>(part, "%s", sql.c_str()))
+            return false;
+
+        if (td->shardKey()) {
+            part.erase(std::remove_if(part.begin(), part.end(), [pool, td, shard](const std::shared_ptr<T> &record) {
+                return readShardID(pool, td, td->shardKeyValue(*record)) != shard;
+            }), part.end());
+        }
+        return true;
+    }, options.timeout, parts, result);
+
+    if (options.less) {
+        mergeSorted<T>(parts, options.less, options.limit, records);
+    } else {
+        for (auto &part : parts) {
+            for (auto &record : part) {
+                if (options.limit && records.size() >= options.limit)
+                    break;
+                records.push_back(record);
+            }
+        }
+    }
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::loadFromAllShards(Records<T> &records, const char *clause, ...) {
+    va_list ap;
+    va_start(ap, clause);
+    bool ret = vloadFromAllShards<T>(records, GatherOptions<T>(), nullptr, clause, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::loadFromAllShards(Records<T> &records, const GatherOptions<T> &options,
+                                                    GatherResult *result, const char *clause, ...) {
+    va_list ap;
+    va_start(ap, clause);
+    bool ret = vloadFromAllShards<T>(records, options, result, clause, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::vcountFromAllShards(uint64_t &count, unsigned int timeout, GatherResult *result,
+                                                      const char *where, va_list ap) {
+    char statement[1024] = "";
+    if (where) {
+        int length = vsnprintf(statement, sizeof(statement), where, ap);
+        if (length < 0 || (size_t) length >= sizeof(statement)) {
+            LOG_ERROR("TinyMySqlORM", "%s: Statement too long: %s", __PRETTY_FUNCTION__, where);
+            return false;
+        }
+    }
+
+    std::string sql = statement;
+    std::vector<uint64_t> counts;
+    bool ret = scatter<uint64_t>([sql](TinyMySqlORM &orm, int, uint64_t &n) {
+        return orm.countFromDB<T>(n, "%s", sql.c_str());
+    }, timeout, counts, result);
+
+    count = 0;
+    for (auto n : counts)
+        count += n;
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::countFromAllShards(uint64_t &count, const char *where, ...) {
+    va_list ap;
+    va_start(ap, where);
+    bool ret = vcountFromAllShards<T>(count, 0, nullptr, where, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::countFromAllShards(uint64_t &count, unsigned int timeout, GatherResult *result,
+                                                     const char *where, ...) {
+    va_list ap;
+    va_start(ap, where);
+    bool ret = vcountFromAllShards<T>(count, timeout, result, where, ap);
+    va_end(ap);
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::writeBatch(const std::vector<const T *> &objs, bool replace,
+                                             std::vector<BatchResult> *results) {
+    auto td = shardedTable<T>();
+    if (!td || !pool_) return false;
+
+    // shared with the shard tasks, like scatterTo()'s state
+    auto batch = std::make_shared<ShardBatch<T>>();
+    for (auto obj : objs) {
+        if (!obj) continue;
+
+        int ids[2];
+        std::string key = td->shardKeyValue(*obj);
+        int count = writeShardIDs(td, key, ids);
+        touch(ids[0], key);
+        batch->add(obj, ids, count);
+    }
+    batch->build(replace, batch_rows_);
+
+    std::map<int, BatchResult> stats;
+    for (auto &it : batch->statements())
+        stats[it.first].shard = it.first;
+
+    //
+    // every shard runs its statements in order, a failed statement stays
+    // pending for the next attempt. The owners first, then the new owners
+    // (dual-writes): a row on its new owner is on its owner already, the
+    // resharding's orphan check relies on it. scatterTo() waits for all
+    // (no timeout): the rows point to the caller's objects.
+    //
+    typedef typename ShardBatch<T>::Phase Phase;
+    for (Phase phase : {ShardBatch<T>::kPhase_Primary, ShardBatch<T>::kPhase_Dual}) {
+        for (unsigned int attempt = 0; attempt <= batch_retries_; ++attempt) {
+            std::vector<int> shards = batch->pending(phase);
+            if (shards.empty())
+                break;
+
+            if (attempt > 0) {
+                LOG_WARN("TinyMySqlORM", "%s: Retry %u, %zu shards", __PRETTY_FUNCTION__, attempt, shards.size());
+                std::this_thread::sleep_for(std::chrono::milliseconds(10 << attempt));
+            }
+
+            for (auto shard : shards)
+                stats[shard].attempts++;
+
+            std::vector<size_t> values;
+            std::vector<int> done;
+            scatterTo<size_t>(shards, [batch, phase](TinyMySqlORM &orm, int shard, size_t &rows) {
+                bool ok = true;
+                rows = batch->run(shard, [&orm](const typename ShardBatch<T>::Statement &statement) {
+                    return statement.replace ? orm.replaceBatch<T>(statement.rows) : orm.insertBatch<T>(statement.rows);
+                }, ok, phase);
+                return ok;
+            }, 0, values, done, false);
+
+            for (size_t i = 0; i < shards.size(); ++i) {
+                stats[shards[i]].rows += values[i];
+                if (values[i] > 0)
+                    markWritten(shards[i]);
+            }
+        }
+    }
+
+    bool ret = true;
+    if (results) results->clear();
+    for (auto &it : batch->statements()) {
+        auto &stat = stats[it.first];
+        for (size_t i = 0; i < it.second.size(); ++i) {
+            if (batch->written(it.first, i)) continue;
+
+            stat.failed += it.second[i].rows.size();
+            if (it.second[i].primary) {
+                ret = false;
+                LOG_ERROR("TinyMySqlORM", "%s: Shard %d, %zu rows FAILED", __PRETTY_FUNCTION__,
+                          it.first, it.second[i].rows.size());
+            } else {
+                LOG_ERROR("TinyMySqlORM", "%s: Dual-write to shard %d, %zu rows FAILED", __PRETTY_FUNCTION__,
+                          it.first, it.second[i].rows.size());
+                for (auto row : it.second[i].rows)
+                    pool_->dualWriteFailed(td->table, td->shardKeyValue(*row));
+            }
+        }
+
+        if (results) results->push_back(stat);
+    }
+
+    return ret;
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::insertBatch(const Records<T> &records, std::vector<BatchResult> *results) {
+    std::vector<const T *> objs;
+    objs.reserve(records.size());
+    for (auto &record : records)
+        objs.push_back(record.get());
+    return writeBatch<T>(objs, false, results);
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::insertBatch(const std::vector<T> &objs, std::vector<BatchResult> *results) {
+    std::vector<const T *> ptrs;
+    ptrs.reserve(objs.size());
+    for (auto &obj : objs)
+        ptrs.push_back(&obj);
+    return writeBatch<T>(ptrs, false, results);
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::replaceBatch(const Records<T> &records, std::vector<BatchResult> *results) {
+    std::vector<const T *> objs;
+    objs.reserve(records.size());
+    for (auto &record : records)
+        objs.push_back(record.get());
+    return writeBatch<T>(objs, true, results);
+}
+
+template<typename T>
+inline bool TinyMySqlShardingORM::replaceBatch(const std::vector<T> &objs, std::vector<BatchResult> *results) {
+    std::vector<const T *> ptrs;
+    ptrs.reserve(objs.size());
+    for (auto &obj : objs)
+        ptrs.push_back(&obj);
+    return writeBatch<T>(ptrs, true, results);
+}
+
+
+//
+// Helper Class: Add sharded database operations to the object.
+// eg.
+//   Object2ShardingDB<Player> player;
+//   player.id = 1024;
+//   player.selectDB();
+//
+template<typename T>
+struct Object2ShardingDB : public T {
+public:
+    using Records = std::vector<std::shared_ptr<T>>;
+
+    Object2ShardingDB() {}
+
+    Object2ShardingDB(const T &object) : T(object) {}
+
+    //
+    // Create, Drop and Update Table's Structure on all the shards
+    //
+    static bool createTable(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template createTableByType<T>();
+    }
+
+    static bool dropTable(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template dropTableByType<T>();
+    }
+
+    static bool updateTable(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template updateTableByType<T>();
+    }
+
+    //
+    // Batch Operations by shard key's values
+    //
+    static bool loadByKeys(Records &records, const std::vector<std::string> &keys,
+                           MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template loadByKeys<T>(records, keys);
+    }
+
+    static bool deleteByKeys(const std::vector<std::string> &keys,
+                             MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template deleteByKeys<T>(keys);
+    }
+
+    //
+    // Scatter-gather over all the shards, see TinyMySqlShardingORM
+    //
+    static bool loadFromAllShards(Records &records,
+                                  const TinyMySqlShardingORM::GatherOptions<T> &options = TinyMySqlShardingORM::GatherOptions<T>(),
+                                  const std::string &clause = "",
+                                  TinyMySqlShardingORM::GatherResult *result = nullptr,
+                                  MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template loadFromAllShards<T>(records, options, result, "%s", clause.c_str());
+    }
+
+    static bool countFromAllShards(uint64_t &count, const std::string &where = "",
+                                   MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template countFromAllShards<T>(count, "%s", where.c_str());
+    }
+
+    static bool insertBatch(const Records &records,
+                            std::vector<TinyMySqlShardingORM::BatchResult> *results = nullptr,
+                            MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template insertBatch<T>(records, results);
+    }
+
+    static bool replaceBatch(const Records &records,
+                             std::vector<TinyMySqlShardingORM::BatchResult> *results = nullptr,
+                             MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template replaceBatch<T>(records, results);
+    }
+
+public:
+    //
+    // Database Operations
+    //
+    bool selectDB(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template select<T>(*this);
+    }
+
+    bool insertDB(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template insert<T>(*this);
+    }
+
+    bool replaceDB(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template replace<T>(*this);
+    }
+
+    bool updateDB(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template update<T>(*this);
+    }
+
+    bool deleteDB(MySqlShardingPool *pool = MySqlShardingPool::instance()) {
+        TinyMySqlShardingORM orm(pool);
+        return orm.template del<T>(*this);
+    }
+};
+
+#endif //TINYWORLD_TINYORM_MYSQL_SHARDING_H
@@ -464,6 +464,7 @@ bool TinySociORM::vloadFromDB(const std::function<void(std::shared_ptr<T>)> &cal
         soci::rowset<soci::row> records = (session_->prepare << "SELECT " << td->sql_fieldlist() << " FROM `"
                                                              << td->table << "` " << statement);
 
+        ProtoLoadBatch batch;
         for (auto it = records.begin(); it != records.end(); ++it) {
             std::shared_ptr<T> obj = std::make_shared<T>();
             if (recordToObject(*it, *obj.get(), td)) {
@@ -471,6 +472,7 @@ bool TinySociORM::vloadFromDB(const std::function<void(std::shared_ptr<T>)> &cal
             } else {
                 LOG_ERROR("TinySociORM", "%s: recordToObject FAILED", __PRETTY_FUNCTION__);
             }
+            batch.next();
         }
     }
     catch (std::exception &err) {
@@ -43,6 +43,8 @@ struct DummySerializer {
     std::string serialize(const T &object) const { return ""; }
 
     bool deserialize(T &object, const std::string &bin) const { return false; }
+
+    bool deserialize(T &object, const char *data, size_t size) const { return false; }
 };
 
 //
@@ -77,6 +79,11 @@ public:
 
     virtual bool deserialize(T &object, const std::string &bin) = 0;
 
+    // Property_T decodes in place, other properties through a copy
+    virtual bool deserialize(T &object, const char *data, size_t size) {
+        return deserialize(object, std::string(data, size));
+    }
+
 protected:
     std::string name_;
     uint16_t number_;
@@ -118,6 +125,24 @@ public:
         return serializer.deserialize(fn_(obj), data);
     }
 
+    bool deserialize(T &obj, const char *data, size_t size) final {
+        SerializerT serializer;
+        return deserialize(serializer, fn_(obj), data, size, 0);
+    }
+
+protected:
+    // serializers without deserialize(object, data, size) get a copy
+    template<typename S>
+    static auto deserialize(const S &serializer, PropType &value, const char *data, size_t size, int)
+    -> decltype(bool(serializer.deserialize(value, data, size))) {
+        return serializer.deserialize(value, data, size);
+    }
+
+    template<typename S>
+    static bool deserialize(const S &serializer, PropType &value, const char *data, size_t size, long) {
+        return serializer.deserialize(value, std::string(data, size));
+    }
+
 protected:
     MemFn fn_;
 };
@@ -35,10 +35,15 @@ TINY_NAMESPACE_BEGIN
 //    struct Serializer {
 //       std::string serialize(const T &object) const;
 //       bool deserialize(T &object, const std::string &bin) const;
+//       bool deserialize(T &object, const char *data, size_t size) const;
 //    };
 //
 // Such as: ProtoSerialzer, ProtoDynSerializer
 //
+// Optional, writing into the caller's buffer (see tinyserializer_proto.h):
+//       size_t byteSize(const T &object) const;
+//       void serializeTo(const T &object, google::protobuf::io::CodedOutputStream *os) const;
+//
 // Usage:
 //   Serializer serializer;
 //   Player p1;
@@ -96,6 +101,12 @@ inline bool deserialize(T &object, const std::string &bin, const SerializerT<T>
     return serializer.deserialize(object, bin);
 }
 
+// from a buffer not owned by a string (a row of the database, a member of a container)
+template<template<typename T> class SerializerT = ProtoSerializer, typename T>
+inline bool deserialize(T &object, const char *data, size_t size, const SerializerT<T> &serializer = SerializerT<T>()) {
+    return serializer.deserialize(object, data, size);
+}
+
 TINY_NAMESPACE_END
 
 
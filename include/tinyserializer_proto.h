@@ -25,14 +25,26 @@
 #ifndef TINYWORLD_TINYSERIALIZER_PROTO_H
 #define TINYWORLD_TINYSERIALIZER_PROTO_H
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <list>
 #include <deque>
 #include <set>
 #include <map>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "tinyworld.h"
 #include "archive.pb.h"
@@ -53,36 +65,6 @@ template<typename T>
 struct ProtoSerializer : public ProtoSerializerImpl<T, ProtoCase<T>::value> {
 };
 
-//
-// Archiver : serialize and deserialize by the same order
-//
-template <template <typename> class SerializerT = ProtoSerializer>
-class ProtoArchiver : public ArchiveProto {
-public:
-    template<typename T>
-    ProtoArchiver &operator<<(const T &object) {
-        ArchiveMemberProto *mem = this->add_members();
-        if (mem) {
-            mem->set_data(serialize<SerializerT>(object));
-        }
-        return *this;
-    }
-
-    template<typename T>
-    ProtoArchiver &operator>>(T &object) {
-        if (read_pos_ < this->members_size()) {
-            const ArchiveMemberProto &mem = this->members(read_pos_);
-            deserialize<SerializerT>(object, mem.data());
-            read_pos_++;
-        }
-        return *this;
-    }
-
-private:
-    int read_pos_ = 0;
-};
-
-
 //
 // Proto Case
 //
@@ -97,6 +79,8 @@ enum ProtoTypeEnum {
     kProtoType_Map,
     kProtoType_HashSet,
     kProtoType_HashMap,
+    kProtoType_Trivial,
+    kProtoType_Array,
 };
 
 template<typename T>
@@ -130,6 +114,11 @@ struct ProtoCase : public std::integral_constant<ProtoTypeEnum,
     struct ProtoCase<MapType<Key, T, Hash, KeyEqual, Allocator> > \
                  : public std::integral_constant<ProtoTypeEnum, kProtoType_HashMap> {}
 
+// std::array
+template<typename T, size_t N>
+struct ProtoCase<std::array<T, N> > : public std::integral_constant<ProtoTypeEnum, kProtoType_Array> {
+};
+
 // Integer
 PROTO_CASE_SCALAR(int8_t, kProtoType_Integer);
 PROTO_CASE_SCALAR(int16_t, kProtoType_Integer);
@@ -168,305 +157,1463 @@ PROTO_CASE_MAP(std::multimap);
 PROTO_CASE_HASHMAP(std::unordered_map);
 PROTO_CASE_HASHMAP(std::unordered_multimap);
 
-
 //
-// Impl ====================================================
+// Writing in place ========================================
 //
-
+// Besides serialize(), a serializer may write straight into the final buffer:
 //
-// Interger
+//    size_t byteSize(const T &object) const;
+//    void serializeTo(const T &object, google::protobuf::io::CodedOutputStream *os) const;
+//
+// byteSize() precomputes the encoded size, serializeTo() writes exactly that
+// many bytes and must follow byteSize() of the same, unchanged object (the
+// sizes cached by protobuf messages, like ByteSizeLong/SerializeWithCachedSizes).
+// All the builtin cases have them, user defined types when they implement
+//
+//    size_t byteSize() const;
+//    void serializeTo(google::protobuf::io::CodedOutputStream *os) const;
+//
+// Containers are written member by member into the caller's buffer instead of
+// nesting serialized strings, the output is byte for byte the same.
+//
+//    std::string buffer;
+//    serializeTo(player, buffer);    // appends
 //
-template<typename T>
-struct ProtoSerializerImpl<T, kProtoType_Integer> {
 
-    std::string serialize(const T &value) const {
-        IntegerProto proto;
-        proto.set_value(value);
-        return proto.SerializeAsString();
+// SerializerT has byteSize() and serializeTo() for T
+template<typename SerializerT, typename T, typename = void>
+struct ProtoSized : public std::false_type {
+};
+
+template<typename SerializerT, typename T>
+struct ProtoSized<SerializerT, T, decltype(std::declval<const SerializerT &>().byteSize(std::declval<const T &>()),
+                                           void())> : public std::true_type {
+};
+
+struct ProtoWire {
+    typedef google::protobuf::io::CodedOutputStream Output;
+    typedef google::protobuf::io::CodedInputStream Input;
+
+    // length delimited field, all the field numbers of archive.proto take a 1 byte tag
+    static uint32_t tag(uint32_t field) { return (field << 3) | 2; }
+
+    static size_t fieldSize(size_t size) { return 1 + Output::VarintSize32((uint32_t) size) + size; }
+
+    // ArchiveMemberProto { data = 1 } embedded as field
+    static size_t memberSize(size_t size) { return fieldSize(fieldSize(size)); }
+
+    template<typename Member>
+    static void writeMember(uint32_t field, const Member &member, Output *os) {
+        os->WriteTag(tag(field));
+        os->WriteVarint32((uint32_t) fieldSize(member.size()));
+        os->WriteTag(tag(1));
+        os->WriteVarint32((uint32_t) member.size());
+        member.write(os);
     }
 
-    bool deserialize(T &value, const std::string &data) const {
-        IntegerProto proto;
-        if (proto.ParseFromString(data)) {
-            value = proto.value();
-            return true;
+    //
+    // Reading: the members are parsed within the limits of their frames and
+    // passed on as views into the input buffer, nothing is copied.
+    //
+
+    // occurrences of a length delimited field in a message, -1 if malformed
+    static int count(const char *data, size_t size, uint32_t field) {
+        Input is((const uint8_t *) data, (int) size);
+        int count = 0;
+        while (uint32_t t = is.ReadTag()) {
+            if (t == tag(field))
+                count++;
+            if (!google::protobuf::internal::WireFormatLite::SkipField(&is, t))
+                return -1;
         }
-        return false;
+        return is.ConsumedEntireMessage() ? count : -1;
     }
-};
 
+    // length delimited bytes, pointing into the input
+    static bool readBytes(Input *is, const char **data, size_t *size) {
+        uint32_t length = 0;
+        if (!is->ReadVarint32(&length))
+            return false;
 
-//
-// Float
-//
-template<typename T>
-struct ProtoSerializerImpl<T, kProtoType_Float> {
+        *data = "";
+        *size = length;
+        if (!length)
+            return true;
 
-    std::string serialize(const T &value) const {
-        FloatProto proto;
-        proto.set_value(value);
-        return proto.SerializeAsString();
+        const void *ptr = nullptr;
+        int available = 0;
+        if (!is->GetDirectBufferPointer(&ptr, &available) || available < (int) length)
+            return false;
+        *data = (const char *) ptr;
+        return is->Skip((int) length);
     }
 
-    bool deserialize(T &value, const std::string &data) const {
-        FloatProto proto;
-        if (proto.ParseFromString(data)) {
-            value = proto.value();
-            return true;
+    // ArchiveMemberProto embedded as field, the last data wins like protobuf's merge
+    static bool readMember(Input *is, const char **data, size_t *size) {
+        uint32_t length = 0;
+        if (!is->ReadVarint32(&length))
+            return false;
+
+        Input::Limit limit = is->PushLimit((int) length);
+        *data = "";
+        *size = 0;
+        while (uint32_t t = is->ReadTag()) {
+            if (t == tag(1)) {
+                if (!readBytes(is, data, size))
+                    return false;
+            } else if (!google::protobuf::internal::WireFormatLite::SkipField(is, t)) {
+                return false;
+            }
         }
-        return false;
+
+        if (!is->ConsumedEntireMessage())
+            return false;
+        is->PopLimit(limit);
+        return true;
     }
-};
 
-//
-// String
-//
-template<typename T>
-struct ProtoSerializerImpl<T, kProtoType_String> {
+    // SequenceProto: fn(data, size) for every member, other(tag, is) reads or skips the other fields
+    template<typename F, typename OtherF>
+    static bool readMembers(const char *data, size_t size, F &&fn, OtherF &&other) {
+        Input is((const uint8_t *) data, (int) size);
+        while (uint32_t t = is.ReadTag()) {
+            if (t != tag(1)) {
+                if (!other(t, &is))
+                    return false;
+                continue;
+            }
 
-    std::string serialize(const T &value) const {
-        StringProto proto;
-        proto.set_value(value);
-        return proto.SerializeAsString();
+            const char *member = nullptr;
+            size_t length = 0;
+            if (!readMember(&is, &member, &length))
+                return false;
+            fn(member, length);
+        }
+        return is.ConsumedEntireMessage();
     }
 
-    bool deserialize(T &value, const std::string &data) const {
-        StringProto proto;
-        if (proto.ParseFromString(data)) {
-            value = proto.value();
-            return true;
+    // AssociateProto: fn(key, key_size, value, value_size) for every pair
+    template<typename F>
+    static bool readPairs(const char *data, size_t size, F &&fn) {
+        Input is((const uint8_t *) data, (int) size);
+        while (uint32_t t = is.ReadTag()) {
+            if (t != tag(1)) {
+                if (!google::protobuf::internal::WireFormatLite::SkipField(&is, t))
+                    return false;
+                continue;
+            }
+
+            uint32_t length = 0;
+            if (!is.ReadVarint32(&length))
+                return false;
+
+            Input::Limit limit = is.PushLimit((int) length);
+            const char *key = "", *value = "";
+            size_t key_size = 0, value_size = 0;
+            while (uint32_t field = is.ReadTag()) {
+                bool ok = true;
+                if (field == tag(1))
+                    ok = readMember(&is, &key, &key_size);
+                else if (field == tag(2))
+                    ok = readMember(&is, &value, &value_size);
+                else
+                    ok = google::protobuf::internal::WireFormatLite::SkipField(&is, field);
+                if (!ok)
+                    return false;
+            }
+
+            if (!is.ConsumedEntireMessage())
+                return false;
+            is.PopLimit(limit);
+            fn(key, key_size, value, value_size);
         }
-        return false;
+        return is.ConsumedEntireMessage();
     }
-};
 
+    // a sized serializer writes into the exact space
+    template<typename SerializerT, typename T>
+    static void append(const SerializerT &serializer, const T &object, std::string &out, std::true_type) {
+        size_t size = serializer.byteSize(object);
+        size_t old = out.size();
+        out.resize(old + size);
+        if (!size) return;
+
+        google::protobuf::io::ArrayOutputStream stream(&out[old], (int) size);
+        Output os(&stream);
+        serializer.serializeTo(object, &os);
+    }
 
-//
-// Generated by Protobuf
-//
-template<typename T>
-struct ProtoSerializerImpl<T, kProtoType_Proto> {
-public:
-    std::string serialize(const T &proto) const {
-        return proto.SerializeAsString();
+    template<typename SerializerT, typename T>
+    static void append(const SerializerT &serializer, const T &object, std::string &out, std::false_type) {
+        out += serializer.serialize(object);
     }
 
-    bool deserialize(T &proto, const std::string &data) const {
-        return proto.ParseFromString(data);
+    template<typename SerializerT, typename T>
+    static bool write(const SerializerT &serializer, const T &object, Output *os, std::true_type) {
+        serializer.byteSize(object);
+        serializer.serializeTo(object, os);
+        return !os->HadError();
     }
-};
 
-//
-// Sequence Container: vector, list, deque
-//
-template<typename T, typename Allocator, template<typename, typename> class Container>
-struct ProtoSerializerImpl<Container<T, Allocator>, kProtoType_Seq> {
+    template<typename SerializerT, typename T>
+    static bool write(const SerializerT &serializer, const T &object, Output *os, std::false_type) {
+        std::string data = serializer.serialize(object);
+        os->WriteRaw(data.data(), (int) data.size());
+        return !os->HadError();
+    }
 
-    std::string serialize(const Container<T, Allocator> &objects) const {
-        SequenceProto proto;
-        ProtoSerializer<T> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
+    // serialize() of the containers: sized, or grown while written when some members are not
+    template<typename SerializerT, typename T>
+    static std::string toString(const SerializerT &serializer, const T &object) {
+        std::string data;
+        toString(serializer, object, data, ProtoSized<SerializerT, T>());
+        return data;
+    }
 
-        return proto.SerializeAsString();
+    template<typename SerializerT, typename T>
+    static void toString(const SerializerT &serializer, const T &object, std::string &data, std::true_type) {
+        append(serializer, object, data, std::true_type());
     }
 
-    bool deserialize(Container<T, Allocator> &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoSerializer<T> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                T obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.push_back(obj);
-            }
-            return true;
-        }
-        return false;
+    template<typename SerializerT, typename T>
+    static void toString(const SerializerT &serializer, const T &object, std::string &data, std::false_type) {
+        google::protobuf::io::StringOutputStream stream(&data);
+        Output os(&stream);
+        serializer.serializeTo(object, &os);
     }
 };
 
 //
-// Set Container: set, multiset
+// A container member: written in place, or serialized once into a string
+// when the member serializer can't size it
 //
-template<typename Key, typename Compare, typename Allocator, template<typename, typename, typename> class Set>
-struct ProtoSerializerImpl<Set<Key, Compare, Allocator>, kProtoType_Set> {
+template<typename SerializerT, typename T, bool sized = ProtoSized<SerializerT, T>::value>
+struct ProtoMember {
+    ProtoMember(const SerializerT &serializer, const T &object)
+            : serializer_(serializer), object_(object), size_(serializer.byteSize(object)) {}
 
-    typedef Set<Key, Compare, Allocator> SetType;
+    size_t size() const { return size_; }
 
-    std::string serialize(const SetType &objects) const {
-        SequenceProto proto;
-        ProtoSerializer<Key> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
+    void write(ProtoWire::Output *os) const { serializer_.serializeTo(object_, os); }
 
-        return proto.SerializeAsString();
-    }
+private:
+    const SerializerT &serializer_;
+    const T &object_;
+    size_t size_;
+};
 
-    bool deserialize(SetType &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoSerializer<Key> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.insert(obj);
-            }
-            return true;
-        }
-        return false;
-    }
+template<typename SerializerT, typename T>
+struct ProtoMember<SerializerT, T, false> {
+    ProtoMember(const SerializerT &serializer, const T &object) : data_(serializer.serialize(object)) {}
+
+    size_t size() const { return data_.size(); }
+
+    void write(ProtoWire::Output *os) const { os->WriteRaw(data_.data(), (int) data_.size()); }
+
+private:
+    std::string data_;
 };
 
+// reserve() for vector and the unordered containers, nothing for the others
+template<typename Container>
+inline auto proto_reserve(Container &objects, size_t count, int) -> decltype(objects.reserve(count), void()) {
+    objects.reserve(objects.size() + count);
+}
+
+template<typename Container>
+inline void proto_reserve(Container &, size_t, long) {}
+
+template<typename Container>
+inline void proto_reserve(Container &objects, size_t count) {
+    proto_reserve(objects, count, 0);
+}
+
 //
-// Map Container: map, multimap
+// Packed scalar containers: sequences and sets of integers, floats and
+// strings are written as one field of SequenceProto instead of a member per
+// value (about 4-5 bytes of framing and a parse each):
 //
-template<typename Key, typename T, typename Compare, typename Allocator, template<typename, typename, typename, typename> class Map>
-struct ProtoSerializerImpl<Map<Key, T, Compare, Allocator>, kProtoType_Map> {
-    typedef Map<Key, T, Compare, Allocator> MapType;
+//    integers = 2 : packed varints, as the uint64 of IntegerProto
+//    floats   = 3 : packed little endian doubles
+//    strings  = 4 : varint length + bytes, per string
+//
+// The reader detects the format by the field, containers written as members
+// (values = 1) before still load. Binaries older than the packed format read
+// a packed container as empty: build with -DTINYSERIALIZER_PACKED=0 to keep
+// writing members until all the readers are upgraded.
+//
+#ifndef TINYSERIALIZER_PACKED
+#define TINYSERIALIZER_PACKED 1
+#endif
 
-    std::string serialize(const MapType &objects) const {
-        AssociateProto proto;
-        ProtoSerializer<Key> key_serializer;
-        ProtoSerializer<T> value_serializer;
-        for (auto &v : objects) {
-            AssociateProto::ValueType *mem = proto.add_values();
-            if (mem) {
-                ArchiveMemberProto *key = mem->mutable_key();
-                ArchiveMemberProto *value = mem->mutable_value();
-                if (key && value) {
-                    key->set_data(key_serializer.serialize(v.first));
-                    value->set_data(value_serializer.serialize(v.second));
-                }
-            }
-        }
+template<typename T, uint32_t proto_case = ProtoCase<T>::value>
+struct ProtoPacked : public std::false_type {
+};
 
-        return proto.SerializeAsString();
+// the packed field of the values, Packing supplies field, size(), write(), read() and count()
+template<typename Packing>
+struct ProtoPackedField : public std::integral_constant<bool, TINYSERIALIZER_PACKED != 0> {
+    template<typename Container>
+    static size_t byteSize(const Container &objects) {
+        size_t size = payload(objects);
+        return size ? ProtoWire::fieldSize(size) : 0;
     }
 
-    bool deserialize(MapType &objects, const std::string &bin) const {
-        AssociateProto proto;
-        ProtoSerializer<Key> key_serializer;
-        ProtoSerializer<T> value_serializer;
-        if (proto.ParseFromString(bin)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key key;
-                T value;
-                if (key_serializer.deserialize(key, proto.values(i).key().data())
-                    && value_serializer.deserialize(value, proto.values(i).value().data())) {
-                    objects.insert(std::make_pair(key, value));
-                }
-            }
-            return true;
+    template<typename Container>
+    static void writeField(const Container &objects, ProtoWire::Output *os) {
+        size_t size = payload(objects);
+        if (!size) return;
+
+        os->WriteTag(ProtoWire::tag(Packing::field));
+        os->WriteVarint32((uint32_t) size);
+        for (const auto &v : objects)
+            Packing::write(v, os);
+    }
+
+    // appends the values of the field, the tag is read
+    template<typename Container>
+    static bool readField(ProtoWire::Input *is, Container &objects) {
+        uint32_t size = 0;
+        if (!is->ReadVarint32(&size))
+            return false;
+
+        ProtoWire::Input::Limit limit = is->PushLimit((int) size);
+        const void *data = nullptr;
+        int available = 0;
+        if (size && is->GetDirectBufferPointer(&data, &available) && available >= (int) size)
+            proto_reserve(objects, Packing::count((const char *) data, size));
+
+        while (is->BytesUntilLimit() > 0) {
+            typename Container::value_type value = typename Container::value_type();
+            if (!Packing::read(is, value))
+                return false;
+            objects.insert(objects.end(), std::move(value));
         }
-        return false;
+
+        is->PopLimit(limit);
+        return true;
+    }
+
+    template<typename Container>
+    static size_t payload(const Container &objects) {
+        size_t size = 0;
+        for (const auto &v : objects)
+            size += Packing::size(v);
+        return size;
     }
 };
 
+template<typename T>
+struct ProtoPacked<T, kProtoType_Integer> : public ProtoPackedField<ProtoPacked<T, kProtoType_Integer> > {
+    static const uint32_t field = 2;
 
-//
-// Hash Set Container: unordered_set, unordered_multiset
-//
-template<typename Key, typename Hash, typename KeyEqual, typename Allocator, template<typename, typename, typename, typename> class Set>
-struct ProtoSerializerImpl<Set<Key, Hash, KeyEqual, Allocator>, kProtoType_HashSet> {
+    static size_t size(const T &value) { return ProtoWire::Output::VarintSize64(static_cast<uint64_t>(value)); }
 
-    typedef Set<Key, Hash, KeyEqual, Allocator> SetType;
+    static void write(const T &value, ProtoWire::Output *os) { os->WriteVarint64(static_cast<uint64_t>(value)); }
 
-    std::string serialize(const SetType &objects) const {
-        SequenceProto proto;
-        ProtoSerializer<Key> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
+    static bool read(ProtoWire::Input *is, T &value) {
+        uint64_t number = 0;
+        if (!is->ReadVarint64(&number))
+            return false;
+        value = static_cast<T>(number);
+        return true;
+    }
 
-        return proto.SerializeAsString();
+    // one varint ends at each byte without the continuation bit
+    static size_t count(const char *data, size_t size) {
+        size_t count = 0;
+        for (size_t i = 0; i < size; ++i)
+            count += !(data[i] & 0x80);
+        return count;
     }
+};
 
-    bool deserialize(SetType &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoSerializer<Key> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.insert(obj);
-            }
-            return true;
-        }
-        return false;
+template<typename T>
+struct ProtoPacked<T, kProtoType_Float> : public ProtoPackedField<ProtoPacked<T, kProtoType_Float> > {
+    static const uint32_t field = 3;
+
+    static size_t size(const T &) { return sizeof(uint64_t); }
+
+    static void write(const T &value, ProtoWire::Output *os) {
+        double number = value;
+        uint64_t bits = 0;
+        memcpy(&bits, &number, sizeof(bits));
+        os->WriteLittleEndian64(bits);
     }
+
+    static bool read(ProtoWire::Input *is, T &value) {
+        uint64_t bits = 0;
+        if (!is->ReadLittleEndian64(&bits))
+            return false;
+        double number = 0;
+        memcpy(&number, &bits, sizeof(number));
+        value = static_cast<T>(number);
+        return true;
+    }
+
+    static size_t count(const char *, size_t size) { return size / sizeof(uint64_t); }
 };
 
+template<typename T>
+struct ProtoPacked<T, kProtoType_String> : public ProtoPackedField<ProtoPacked<T, kProtoType_String> > {
+    static const uint32_t field = 4;
+
+    static size_t size(const T &value) { return ProtoWire::Output::VarintSize32((uint32_t) value.size()) + value.size(); }
+
+    static void write(const T &value, ProtoWire::Output *os) {
+        os->WriteVarint32((uint32_t) value.size());
+        os->WriteRaw(value.data(), (int) value.size());
+    }
+
+    static bool read(ProtoWire::Input *is, T &value) {
+        uint32_t size = 0;
+        return is->ReadVarint32(&size) && is->ReadString(&value, (int) size);
+    }
+
+    static size_t count(const char *data, size_t size) {
+        ProtoWire::Input is((const uint8_t *) data, (int) size);
+        size_t count = 0;
+        uint32_t length = 0;
+        while (is.ReadVarint32(&length) && is.Skip((int) length))
+            count++;
+        return count;
+    }
+};
 
 //
-// Hash Map Container: unordered_map, unordered_multimap
+// Trivially copyable values: opt-in for structs of plain data (grid cells,
+// stat tables), std::array of arithmetic types take the same path:
 //
-template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator,
-        template<typename, typename, typename, typename, typename> class Map>
-struct ProtoSerializerImpl<Map<Key, T, Hash, KeyEqual, Allocator>, kProtoType_HashMap> {
-    typedef Map<Key, T, Hash, KeyEqual, Allocator> MapType;
+//    struct GridCell { int32_t x, y; uint8_t terrain, height; uint16_t flags; };
+//    PROTO_CASE_TRIVIAL(GridCell, 100, 4 + 4 + 1 + 1 + 2);
+//
+// The last argument is the sum of the members' sizes, it must be sizeof(T):
+// the padding bytes are uninitialized, stored they would leak memory and
+// change the output from run to run. Reorder or pad the members by hand.
+// No bool members either: a bool read from any other byte than 0 and 1 is
+// undefined (a bool value alone is checked).
+//
+// A GridCell is stored as its bytes, a vector, deque, list or std::array of
+// them as one blob: TrivialProto { size, tag, count, data } in field 5 of
+// SequenceProto, read back into a vector or an array by one memcpy. The
+// element size and the tag (a number from kProtoTrivial_User on, naming the
+// layout: change it with the struct) must match when reading.
+//
+// The data is little endian, big endian hosts swap every element by
+// ProtoTrivialSwap<T>: builtin for arithmetic types, structs have to
+// specialize it there (or fail to compile).
+//
+enum ProtoTrivialTagEnum {
+    kProtoTrivial_Unsigned = 1,
+    kProtoTrivial_Signed = 2,
+    kProtoTrivial_Float = 3,
+    kProtoTrivial_Bool = 4,
+    kProtoTrivial_User = 16,
+};
 
-    std::string serialize(const MapType &objects) const {
-        AssociateProto proto;
-        ProtoSerializer<Key> key_serializer;
-        ProtoSerializer<T> value_serializer;
-        for (auto &v : objects) {
-            AssociateProto::ValueType *mem = proto.add_values();
-            if (mem) {
-                ArchiveMemberProto *key = mem->mutable_key();
-                ArchiveMemberProto *value = mem->mutable_value();
-                if (key && value) {
-                    key->set_data(key_serializer.serialize(v.first));
-                    value->set_data(value_serializer.serialize(v.second));
-                }
-            }
-        }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define TINYSERIALIZER_BIG_ENDIAN 1
+#else
+#define TINYSERIALIZER_BIG_ENDIAN 0
+#endif
 
-        return proto.SerializeAsString();
+template<typename T, typename Enable = void>
+struct ProtoTrivial : public std::false_type {
+};
+
+template<typename T>
+struct ProtoTrivial<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> : public std::true_type {
+    static const uint32_t tag = std::is_same<T, bool>::value ? kProtoTrivial_Bool
+                                : std::is_floating_point<T>::value ? kProtoTrivial_Float
+                                : std::is_signed<T>::value ? kProtoTrivial_Signed : kProtoTrivial_Unsigned;
+};
+
+// Trivial Type Case
+#define PROTO_CASE_TRIVIAL(TrivialType, Tag, MemberBytes) \
+    template<> struct ProtoCase<TrivialType> : public std::integral_constant<ProtoTypeEnum, kProtoType_Trivial> {}; \
+    template<> struct ProtoTrivial<TrivialType> : public std::true_type { \
+        static_assert(std::is_trivially_copyable<TrivialType>::value, #TrivialType " is not trivially copyable"); \
+        static_assert(sizeof(TrivialType) == (MemberBytes), #TrivialType " has padding bytes"); \
+        static const uint32_t tag = Tag; \
     }
 
-    bool deserialize(MapType &objects, const std::string &bin) const {
-        AssociateProto proto;
-        ProtoSerializer<Key> key_serializer;
-        ProtoSerializer<T> value_serializer;
-        if (proto.ParseFromString(bin)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key key;
-                T value;
-                if (key_serializer.deserialize(key, proto.values(i).key().data())
-                    && value_serializer.deserialize(value, proto.values(i).value().data())) {
-                    objects.insert(std::make_pair(key, value));
-                }
-            }
-            return true;
-        }
-        return false;
+template<typename T, typename Enable = void>
+struct ProtoTrivialSwap;
+
+template<typename T>
+struct ProtoTrivialSwap<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+    static void swap(T &value) {
+        unsigned char *bytes = reinterpret_cast<unsigned char *>(&value);
+        std::reverse(bytes, bytes + sizeof(T));
     }
 };
 
-//
-// User Defined
-//
 template<typename T>
-struct ProtoSerializerImpl<T, kProtoType_UserDefined> {
-public:
-    std::string serialize(const T &object) const {
-        return object.serialize();
+struct ProtoTrivialField : public std::true_type {
+    static const uint32_t field = 5;
+
+    // TrivialProto { size = 1, tag = 2, count = 3, data = 4 } of count values
+    static size_t messageSize(size_t count) {
+        return 1 + ProtoWire::Output::VarintSize32(sizeof(T))
+               + 1 + ProtoWire::Output::VarintSize32(ProtoTrivial<T>::tag)
+               + 1 + ProtoWire::Output::VarintSize64(count)
+               + ProtoWire::fieldSize(count * sizeof(T));
     }
 
-    bool deserialize(T &object, const std::string &data) const {
-        return object.deserialize(data);
+    static void writeHeader(size_t count, ProtoWire::Output *os) {
+        os->WriteTag(1 << 3);
+        os->WriteVarint32(sizeof(T));
+        os->WriteTag(2 << 3);
+        os->WriteVarint32(ProtoTrivial<T>::tag);
+        os->WriteTag(3 << 3);
+        os->WriteVarint64(count);
+        os->WriteTag(ProtoWire::tag(4));
+        os->WriteVarint32((uint32_t) (count * sizeof(T)));
+    }
+
+    // contiguous values
+    static void writeValues(const T *values, size_t count, ProtoWire::Output *os) {
+#if TINYSERIALIZER_BIG_ENDIAN
+        writeValues(values, values + count, os);
+#else
+        os->WriteRaw(values, (int) (count * sizeof(T)));
+#endif
+    }
+
+    template<typename Iterator>
+    static void writeValues(Iterator first, Iterator last, ProtoWire::Output *os) {
+        for (; first != last; ++first) {
+            T value = *first;
+#if TINYSERIALIZER_BIG_ENDIAN
+            ProtoTrivialSwap<T>::swap(value);
+#endif
+            os->WriteRaw(&value, sizeof(T));
+        }
+    }
+
+    // the TrivialProto up to the current limit, data points into the input
+    static bool parse(ProtoWire::Input *is, const char **data, size_t *count) {
+        uint32_t size = 0, tag = 0;
+        uint64_t values = 0;
+        const char *bytes = "";
+        size_t length = 0;
+        while (uint32_t t = is->ReadTag()) {
+            bool ok = true;
+            if (t == (1 << 3))
+                ok = is->ReadVarint32(&size);
+            else if (t == (2 << 3))
+                ok = is->ReadVarint32(&tag);
+            else if (t == (3 << 3))
+                ok = is->ReadVarint64(&values);
+            else if (t == ProtoWire::tag(4))
+                ok = ProtoWire::readBytes(is, &bytes, &length);
+            else
+                ok = google::protobuf::internal::WireFormatLite::SkipField(is, t);
+            if (!ok)
+                return false;
+        }
+
+        // another layout is not readable as T
+        if (!is->ConsumedEntireMessage() || size != sizeof(T) || tag != ProtoTrivial<T>::tag
+            || length % sizeof(T) || values != length / sizeof(T) || !valid(bytes, length))
+            return false;
+
+        *data = bytes;
+        *count = (size_t) values;
+        return true;
+    }
+
+    // a bool is 0 or 1, anything else copied into one is undefined
+    template<typename U = T>
+    static typename std::enable_if<std::is_same<U, bool>::value, bool>::type
+    valid(const char *data, size_t length) {
+        for (size_t i = 0; i < length; ++i)
+            if ((unsigned char) data[i] > 1)
+                return false;
+        return true;
+    }
+
+    template<typename U = T>
+    static typename std::enable_if<!std::is_same<U, bool>::value, bool>::type
+    valid(const char *, size_t) {
+        return true;
+    }
+
+    static void copy(T *values, const char *data, size_t count) {
+        if (!count) return;
+        memcpy(values, data, count * sizeof(T));
+#if TINYSERIALIZER_BIG_ENDIAN
+        for (size_t i = 0; i < count; ++i)
+            ProtoTrivialSwap<T>::swap(values[i]);
+#endif
+    }
+
+    // the field of a container, as the packed fields
+    template<typename Container>
+    static size_t byteSize(const Container &objects) {
+        return objects.empty() ? 0 : ProtoWire::fieldSize(messageSize(objects.size()));
+    }
+
+    template<typename Container>
+    static void writeField(const Container &objects, ProtoWire::Output *os) {
+        if (objects.empty()) return;
+
+        os->WriteTag(ProtoWire::tag(field));
+        os->WriteVarint32((uint32_t) messageSize(objects.size()));
+        writeHeader(objects.size(), os);
+        write(objects, os);
+    }
+
+    // appends the values of the field, the tag is read
+    template<typename Container>
+    static bool readField(ProtoWire::Input *is, Container &objects) {
+        const char *data = nullptr;
+        size_t count = 0;
+        if (!readMessage(is, &data, &count))
+            return false;
+
+        append(objects, data, count);
+        return true;
+    }
+
+    static bool readMessage(ProtoWire::Input *is, const char **data, size_t *count) {
+        uint32_t length = 0;
+        if (!is->ReadVarint32(&length))
+            return false;
+
+        ProtoWire::Input::Limit limit = is->PushLimit((int) length);
+        if (!parse(is, data, count))
+            return false;
+        is->PopLimit(limit);
+        return true;
+    }
+
+protected:
+    // vector<bool> has no data()
+    template<typename Allocator, typename U = T>
+    static typename std::enable_if<!std::is_same<U, bool>::value>::type
+    write(const std::vector<U, Allocator> &objects, ProtoWire::Output *os) {
+        writeValues(objects.data(), objects.size(), os);
+    }
+
+    template<typename Container>
+    static void write(const Container &objects, ProtoWire::Output *os) {
+        writeValues(objects.begin(), objects.end(), os);
+    }
+
+    // into the grown storage of a vector
+    template<typename Allocator, typename U = T>
+    static typename std::enable_if<!std::is_same<U, bool>::value>::type
+    append(std::vector<U, Allocator> &objects, const char *data, size_t count) {
+        size_t size = objects.size();
+        objects.resize(size + count);
+        copy(objects.data() + size, data, count);
+    }
+
+    template<typename Container>
+    static void append(Container &objects, const char *data, size_t count) {
+        proto_reserve(objects, count);
+        for (size_t i = 0; i < count; ++i) {
+            T value;
+            copy(&value, data + i * sizeof(T), 1);
+            objects.insert(objects.end(), value);
+        }
+    }
+};
+
+template<typename T>
+struct ProtoPacked<T, kProtoType_Trivial> : public ProtoTrivialField<T> {
+};
+
+//
+// reads the packed or the trivial field of T's values, skips any other
+//
+template<typename Packing, typename Container>
+inline int proto_read_field(uint32_t tag, ProtoWire::Input *is, Container &objects, std::true_type) {
+    if (tag != ProtoWire::tag(Packing::field))
+        return -1;
+    return Packing::readField(is, objects) ? 1 : 0;
+}
+
+template<typename Packing, typename Container>
+inline int proto_read_field(uint32_t, ProtoWire::Input *, Container &, std::false_type) {
+    return -1;
+}
+
+template<typename T, typename Container>
+inline bool proto_read_packed(uint32_t tag, ProtoWire::Input *is, Container &objects) {
+    int read = proto_read_field<ProtoPacked<T> >(tag, is, objects, std::integral_constant<bool,
+            ProtoCase<T>::value == kProtoType_Integer || ProtoCase<T>::value == kProtoType_Float
+            || ProtoCase<T>::value == kProtoType_String>());
+    if (read < 0)
+        read = proto_read_field<ProtoTrivialField<T> >(tag, is, objects, ProtoTrivial<T>());
+    if (read < 0)
+        return google::protobuf::internal::WireFormatLite::SkipField(is, tag);
+    return read > 0;
+}
+
+//
+// Arena of the temporary messages (ProtoDynSerializer's DynamicMessage per
+// user defined object): while a Scope is open, the serializers of the thread
+// build them on its arena instead of a new/delete per message and field,
+// reset() frees them all at once. The initial block is kept across resets.
+// Without a scope they go to the thread's own arena, reset when the
+// outermost serializer call returns.
+//
+//    ProtoArena arena;
+//    ProtoArena::Scope scope(arena);
+//    for (auto &data : rows) {
+//        deserialize<ProtoDynSerializer>(obj, data);
+//        arena.reset();
+//    }
+//
+// Only ProtoDynSerializer built with TINYSERIALIZER_DYN_REFLECTION=1 makes
+// temporary messages (ProtoTempMessage), the default wire path and
+// ProtoSerializer never touch an arena. So the ORM's load loops open a
+// ProtoLoadBatch: a Batch (the caller's scope, or an arena of the thread
+// reset after every row) in that build, nothing otherwise.
+//
+#ifndef TINYSERIALIZER_DYN_REFLECTION
+#define TINYSERIALIZER_DYN_REFLECTION 0
+#endif
+
+class ProtoArena {
+public:
+    explicit ProtoArena(size_t initial_block = 64 * 1024)
+            : block_(initial_block ? new char[initial_block] : nullptr),
+              arena_(options(block_.get(), initial_block)) {}
+
+    ProtoArena(const ProtoArena &) = delete;
+
+    ProtoArena &operator=(const ProtoArena &) = delete;
+
+    google::protobuf::Arena *arena() { return &arena_; }
+
+    size_t allocated() const { return (size_t) arena_.SpaceAllocated(); }
+
+    // the messages built on it must not be used any more
+    void reset() { arena_.Reset(); }
+
+    class Scope {
+    public:
+        explicit Scope(ProtoArena &arena) : previous_(current_()) { current_() = &arena; }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() { current_() = previous_; }
+
+    private:
+        ProtoArena *previous_;
+    };
+
+    //
+    // A loop of deserializations (the rows of a load): in the caller's scope,
+    // or on the thread's arena, reset by next()
+    //
+    class Batch {
+    public:
+        Batch() : own_(!current()), scope_(own_ ? local() : *current()) {}
+
+        void next() {
+            if (own_) local().reset();
+        }
+
+    private:
+        bool own_;
+        Scope scope_;
+    };
+
+    // of the innermost open scope of the thread, or nullptr
+    static ProtoArena *current() { return current_(); }
+
+    // the thread's own, for the ORM
+    static ProtoArena &local() {
+        static thread_local ProtoArena arena;
+        return arena;
+    }
+
+private:
+    static ProtoArena *&current_() {
+        static thread_local ProtoArena *arena = nullptr;
+        return arena;
+    }
+
+    static google::protobuf::ArenaOptions options(char *block, size_t size) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block;
+        options.initial_block_size = block ? size : 0;
+        return options;
+    }
+
+    std::unique_ptr<char[]> block_;
+    google::protobuf::Arena arena_;
+};
+
+//
+// A temporary message: on the current arena, or on the thread's own arena,
+// reset when the outermost temporary is released
+//
+class ProtoTempMessage {
+public:
+    explicit ProtoTempMessage(const google::protobuf::Message *prototype)
+            : message_(prototype->New(ProtoArena::current()->arena())) {}
+
+    ProtoTempMessage(const ProtoTempMessage &) = delete;
+
+    ProtoTempMessage &operator=(const ProtoTempMessage &) = delete;
+
+    ~ProtoTempMessage() { batch_.next(); }
+
+    google::protobuf::Message *get() const { return message_; }
+
+    google::protobuf::Message *operator->() const { return message_; }
+
+private:
+    ProtoArena::Batch batch_;
+    google::protobuf::Message *message_;
+};
+
+#if TINYSERIALIZER_DYN_REFLECTION
+typedef ProtoArena::Batch ProtoLoadBatch;
+#else
+struct ProtoLoadBatch {
+    void next() {}
+};
+#endif
+
+//
+// serializeTo: append to a string, or write to a protobuf stream
+//
+template<template<typename> class SerializerT = ProtoSerializer, typename T>
+inline void serializeTo(const T &object, std::string &out, const SerializerT<T> &serializer = SerializerT<T>()) {
+    ProtoWire::append(serializer, object, out, ProtoSized<SerializerT<T>, T>());
+}
+
+template<template<typename> class SerializerT = ProtoSerializer, typename T>
+inline bool serializeTo(const T &object, google::protobuf::io::ZeroCopyOutputStream *out,
+                        const SerializerT<T> &serializer = SerializerT<T>()) {
+    ProtoWire::Output os(out);
+    return ProtoWire::write(serializer, object, &os, ProtoSized<SerializerT<T>, T>());
+}
+
+//
+// Archiver : serialize and deserialize by the same order
+//
+template <template <typename> class SerializerT = ProtoSerializer>
+class ProtoArchiver : public ArchiveProto {
+public:
+    template<typename T>
+    ProtoArchiver &operator<<(const T &object) {
+        ArchiveMemberProto *mem = this->add_members();
+        if (mem) {
+            // not written in place: the object may be this archiver
+            std::string data;
+            serializeTo<SerializerT>(object, data);
+            mem->mutable_data()->swap(data);
+        }
+        return *this;
+    }
+
+    template<typename T>
+    ProtoArchiver &operator>>(T &object) {
+        if (read_pos_ < this->members_size()) {
+            const ArchiveMemberProto &mem = this->members(read_pos_);
+            deserialize<SerializerT>(object, mem.data());
+            read_pos_++;
+        }
+        return *this;
+    }
+
+private:
+    int read_pos_ = 0;
+};
+
+
+//
+// Containers ==============================================
+//
+// Shared by ProtoSerializer and ProtoDynSerializer, the members are
+// serialized by SerializerT.
+//
+// Deserializing appends to the container, like before. The elements are
+// decoded in place (or moved in), the container is reserved for all the
+// incoming members, and the ordered containers insert with end() as the hint
+// since the members were serialized in order. To reuse a live container's
+// memory, clear() it and deserialize into it.
+//
+
+//
+// Sequence: vector, list, deque
+//
+template<typename Container, template<typename> class SerializerT>
+struct ProtoSeqSerializer {
+    typedef typename Container::value_type T;
+
+    // SequenceProto
+    std::string serialize(const Container &objects) const {
+        return ProtoWire::toString(*this, objects);
+    }
+
+    template<typename C = Container>
+    typename std::enable_if<ProtoSized<SerializerT<typename C::value_type>, typename C::value_type>::value,
+            size_t>::type
+    byteSize(const C &objects) const {
+        return byteSize(objects, ProtoPacked<T>());
+    }
+
+    void serializeTo(const Container &objects, ProtoWire::Output *os) const {
+        serializeTo(objects, os, ProtoPacked<T>());
+    }
+
+    bool deserialize(Container &objects, const std::string &data) const {
+        return deserialize(objects, data.data(), data.size());
+    }
+
+    bool deserialize(Container &objects, const char *data, size_t size) const {
+        int count = ProtoWire::count(data, size, 1);
+        if (count < 0)
+            return false;
+
+        proto_reserve(objects, count);
+        SerializerT<T> member_serializer;
+        return ProtoWire::readMembers(data, size, [&](const char *member, size_t length) {
+            append(objects, member_serializer, member, length, std::is_same<typename Container::reference, T &>());
+        }, [&](uint32_t tag, ProtoWire::Input *is) {
+            return proto_read_packed<T>(tag, is, objects);
+        });
+    }
+
+protected:
+    size_t byteSize(const Container &objects, std::true_type) const {
+        return ProtoPacked<T>::byteSize(objects);
+    }
+
+    size_t byteSize(const Container &objects, std::false_type) const {
+        SerializerT<T> member_serializer;
+        size_t size = 0;
+        for (const auto &v : objects)
+            size += ProtoWire::memberSize(member_serializer.byteSize(v));
+        return size;
+    }
+
+    void serializeTo(const Container &objects, ProtoWire::Output *os, std::true_type) const {
+        ProtoPacked<T>::writeField(objects, os);
+    }
+
+    void serializeTo(const Container &objects, ProtoWire::Output *os, std::false_type) const {
+        SerializerT<T> member_serializer;
+        for (const auto &v : objects)
+            ProtoWire::writeMember(1, ProtoMember<SerializerT<T>, T>(member_serializer, v), os);
+    }
+
+    // decoded in the container's own slot, dropped if the member is malformed
+    static void append(Container &objects, const SerializerT<T> &member_serializer,
+                       const char *data, size_t size, std::true_type) {
+        objects.emplace_back();
+        try {
+            if (!member_serializer.deserialize(objects.back(), data, size))
+                objects.pop_back();
+        }
+        catch (...) {
+            objects.pop_back();
+            throw;
+        }
+    }
+
+    // proxy references (vector<bool>)
+    static void append(Container &objects, const SerializerT<T> &member_serializer,
+                       const char *data, size_t size, std::false_type) {
+        T obj = T();
+        if (member_serializer.deserialize(obj, data, size))
+            objects.push_back(std::move(obj));
+    }
+};
+
+//
+// Set: set, multiset, unordered_set, unordered_multiset
+//
+template<typename SetType, template<typename> class SerializerT>
+struct ProtoSetSerializer {
+    typedef typename SetType::key_type Key;
+
+    // SequenceProto
+    std::string serialize(const SetType &objects) const {
+        return ProtoWire::toString(*this, objects);
+    }
+
+    template<typename S = SetType>
+    typename std::enable_if<ProtoSized<SerializerT<typename S::key_type>, typename S::key_type>::value,
+            size_t>::type
+    byteSize(const S &objects) const {
+        return byteSize(objects, ProtoPacked<Key>());
+    }
+
+    void serializeTo(const SetType &objects, ProtoWire::Output *os) const {
+        serializeTo(objects, os, ProtoPacked<Key>());
+    }
+
+    bool deserialize(SetType &objects, const std::string &data) const {
+        return deserialize(objects, data.data(), data.size());
+    }
+
+    bool deserialize(SetType &objects, const char *data, size_t size) const {
+        int count = ProtoWire::count(data, size, 1);
+        if (count < 0)
+            return false;
+
+        proto_reserve(objects, count);
+        SerializerT<Key> member_serializer;
+        return ProtoWire::readMembers(data, size, [&](const char *member, size_t length) {
+            Key obj = Key();
+            if (member_serializer.deserialize(obj, member, length))
+                objects.emplace_hint(objects.end(), std::move(obj));
+        }, [&](uint32_t tag, ProtoWire::Input *is) {
+            return proto_read_packed<Key>(tag, is, objects);
+        });
+    }
+
+protected:
+    size_t byteSize(const SetType &objects, std::true_type) const {
+        return ProtoPacked<Key>::byteSize(objects);
+    }
+
+    size_t byteSize(const SetType &objects, std::false_type) const {
+        SerializerT<Key> member_serializer;
+        size_t size = 0;
+        for (auto &v : objects)
+            size += ProtoWire::memberSize(member_serializer.byteSize(v));
+        return size;
+    }
+
+    void serializeTo(const SetType &objects, ProtoWire::Output *os, std::true_type) const {
+        ProtoPacked<Key>::writeField(objects, os);
+    }
+
+    void serializeTo(const SetType &objects, ProtoWire::Output *os, std::false_type) const {
+        SerializerT<Key> member_serializer;
+        for (auto &v : objects)
+            ProtoWire::writeMember(1, ProtoMember<SerializerT<Key>, Key>(member_serializer, v), os);
+    }
+};
+
+//
+// Map: map, multimap, unordered_map, unordered_multimap
+//
+template<typename MapType, template<typename> class SerializerT>
+struct ProtoMapSerializer {
+    typedef typename MapType::key_type Key;
+    typedef typename MapType::mapped_type T;
+
+    // AssociateProto
+    std::string serialize(const MapType &objects) const {
+        return ProtoWire::toString(*this, objects);
+    }
+
+    template<typename M = MapType>
+    typename std::enable_if<ProtoSized<SerializerT<typename M::key_type>, typename M::key_type>::value
+                            && ProtoSized<SerializerT<typename M::mapped_type>, typename M::mapped_type>::value,
+            size_t>::type
+    byteSize(const M &objects) const {
+        SerializerT<Key> key_serializer;
+        SerializerT<T> value_serializer;
+        size_t size = 0;
+        for (auto &v : objects)
+            size += ProtoWire::fieldSize(ProtoWire::memberSize(key_serializer.byteSize(v.first))
+                                         + ProtoWire::memberSize(value_serializer.byteSize(v.second)));
+        return size;
+    }
+
+    void serializeTo(const MapType &objects, ProtoWire::Output *os) const {
+        SerializerT<Key> key_serializer;
+        SerializerT<T> value_serializer;
+        for (auto &v : objects) {
+            ProtoMember<SerializerT<Key>, Key> key(key_serializer, v.first);
+            ProtoMember<SerializerT<T>, T> value(value_serializer, v.second);
+
+            // AssociateProto::ValueType { key = 1, value = 2 }
+            os->WriteTag(ProtoWire::tag(1));
+            os->WriteVarint32((uint32_t) (ProtoWire::memberSize(key.size()) + ProtoWire::memberSize(value.size())));
+            ProtoWire::writeMember(1, key, os);
+            ProtoWire::writeMember(2, value, os);
+        }
+    }
+
+    bool deserialize(MapType &objects, const std::string &bin) const {
+        return deserialize(objects, bin.data(), bin.size());
+    }
+
+    bool deserialize(MapType &objects, const char *data, size_t size) const {
+        int count = ProtoWire::count(data, size, 1);
+        if (count < 0)
+            return false;
+
+        proto_reserve(objects, count);
+        SerializerT<Key> key_serializer;
+        SerializerT<T> value_serializer;
+        return ProtoWire::readPairs(data, size, [&](const char *key_data, size_t key_size,
+                                                    const char *value_data, size_t value_size) {
+            Key key = Key();
+            if (!key_serializer.deserialize(key, key_data, key_size))
+                return;
+
+            // the value is decoded in the inserted node
+            size_t before = objects.size();
+            typename MapType::iterator it = objects.emplace_hint(objects.end(), std::piecewise_construct,
+                                                                 std::forward_as_tuple(std::move(key)),
+                                                                 std::forward_as_tuple());
+            // key already in a unique map: keep the existing value, as insert() does
+            if (objects.size() == before)
+                return;
+
+            try {
+                if (!value_serializer.deserialize(it->second, value_data, value_size))
+                    objects.erase(it);
+            }
+            catch (...) {
+                objects.erase(it);
+                throw;
+            }
+        });
+    }
+};
+
+//
+// Array: std::array
+//
+// Written as a sequence. Reading assigns the first values and leaves the
+// rest of the array as it is, more values than N fail.
+//
+template<typename Array, template<typename> class SerializerT,
+        bool trivial = ProtoTrivial<typename Array::value_type>::value>
+struct ProtoArraySerializer : public ProtoSeqSerializer<Array, SerializerT> {
+    typedef typename Array::value_type T;
+
+    bool deserialize(Array &objects, const std::string &data) const {
+        return deserialize(objects, data.data(), data.size());
+    }
+
+    // through a vector
+    bool deserialize(Array &objects, const char *data, size_t size) const {
+        std::vector<T> values;
+        if (!ProtoSeqSerializer<std::vector<T>, SerializerT>().deserialize(values, data, size)
+            || values.size() > objects.size())
+            return false;
+
+        std::move(values.begin(), values.end(), objects.begin());
+        return true;
+    }
+};
+
+// trivially copyable values: the blob is copied into the array
+template<typename Array, template<typename> class SerializerT>
+struct ProtoArraySerializer<Array, SerializerT, true> : public ProtoArraySerializer<Array, SerializerT, false> {
+    typedef typename Array::value_type T;
+
+    std::string serialize(const Array &objects) const {
+        return ProtoWire::toString(*this, objects);
+    }
+
+    size_t byteSize(const Array &objects) const {
+        return ProtoTrivialField<T>::byteSize(objects);
+    }
+
+    void serializeTo(const Array &objects, ProtoWire::Output *os) const {
+        ProtoTrivialField<T>::writeField(objects, os);
+    }
+
+    bool deserialize(Array &objects, const std::string &data) const {
+        return deserialize(objects, data.data(), data.size());
+    }
+
+    bool deserialize(Array &objects, const char *data, size_t size) const {
+        ProtoWire::Input is(reinterpret_cast<const uint8_t *>(data), (int) size);
+        if (is.ReadTag() != ProtoWire::tag(ProtoTrivialField<T>::field))
+            return ProtoArraySerializer<Array, SerializerT, false>::deserialize(objects, data, size);
+
+        const char *values = nullptr;
+        size_t count = 0;
+        if (!ProtoTrivialField<T>::readMessage(&is, &values, &count) || count > objects.size())
+            return false;
+
+        // written by another container: more values may follow
+        if (is.ReadTag() != 0 || !is.ConsumedEntireMessage())
+            return ProtoArraySerializer<Array, SerializerT, false>::deserialize(objects, data, size);
+
+        ProtoTrivialField<T>::copy(objects.data(), values, count);
+        return true;
+    }
+};
+
+//
+// Impl ====================================================
+//
+
+//
+// Interger
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_Integer> {
+
+    std::string serialize(const T &value) const {
+        IntegerProto proto;
+        proto.set_value(value);
+        return proto.SerializeAsString();
+    }
+
+    // IntegerProto { uint64 value = 1 }
+    size_t byteSize(const T &value) const {
+        return 1 + ProtoWire::Output::VarintSize64(static_cast<uint64_t>(value));
+    }
+
+    void serializeTo(const T &value, ProtoWire::Output *os) const {
+        os->WriteTag(1 << 3);
+        os->WriteVarint64(static_cast<uint64_t>(value));
+    }
+
+    bool deserialize(T &value, const std::string &data) const {
+        return deserialize(value, data.data(), data.size());
+    }
+
+    bool deserialize(T &value, const char *data, size_t size) const {
+        IntegerProto proto;
+        if (proto.ParseFromArray(data, (int) size)) {
+            value = proto.value();
+            return true;
+        }
+        return false;
+    }
+};
+
+
+//
+// Float
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_Float> {
+
+    std::string serialize(const T &value) const {
+        FloatProto proto;
+        proto.set_value(value);
+        return proto.SerializeAsString();
+    }
+
+    // FloatProto { double value = 1 }
+    size_t byteSize(const T &) const {
+        return 1 + sizeof(uint64_t);
+    }
+
+    void serializeTo(const T &value, ProtoWire::Output *os) const {
+        double number = value;
+        uint64_t bits = 0;
+        memcpy(&bits, &number, sizeof(bits));
+        os->WriteTag((1 << 3) | 1);
+        os->WriteLittleEndian64(bits);
+    }
+
+    bool deserialize(T &value, const std::string &data) const {
+        return deserialize(value, data.data(), data.size());
+    }
+
+    bool deserialize(T &value, const char *data, size_t size) const {
+        FloatProto proto;
+        if (proto.ParseFromArray(data, (int) size)) {
+            value = proto.value();
+            return true;
+        }
+        return false;
+    }
+};
+
+//
+// String
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_String> {
+
+    std::string serialize(const T &value) const {
+        StringProto proto;
+        proto.set_value(value);
+        return proto.SerializeAsString();
+    }
+
+    // StringProto { bytes value = 1 }
+    size_t byteSize(const T &value) const {
+        return ProtoWire::fieldSize(value.size());
+    }
+
+    void serializeTo(const T &value, ProtoWire::Output *os) const {
+        os->WriteTag(ProtoWire::tag(1));
+        os->WriteVarint32((uint32_t) value.size());
+        os->WriteRaw(value.data(), (int) value.size());
+    }
+
+    bool deserialize(T &value, const std::string &data) const {
+        return deserialize(value, data.data(), data.size());
+    }
+
+    bool deserialize(T &value, const char *data, size_t size) const {
+        StringProto proto;
+        if (proto.ParseFromArray(data, (int) size)) {
+            value.swap(*proto.mutable_value());
+            return true;
+        }
+        return false;
+    }
+};
+
+
+//
+// Trivially Copyable: PROTO_CASE_TRIVIAL
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_Trivial> {
+
+    std::string serialize(const T &value) const {
+        return ProtoWire::toString(*this, value);
+    }
+
+    // TrivialProto of one value
+    size_t byteSize(const T &) const {
+        return ProtoTrivialField<T>::messageSize(1);
+    }
+
+    void serializeTo(const T &value, ProtoWire::Output *os) const {
+        ProtoTrivialField<T>::writeHeader(1, os);
+        ProtoTrivialField<T>::writeValues(&value, 1, os);
+    }
+
+    bool deserialize(T &value, const std::string &data) const {
+        return deserialize(value, data.data(), data.size());
+    }
+
+    bool deserialize(T &value, const char *data, size_t size) const {
+        ProtoWire::Input is(reinterpret_cast<const uint8_t *>(data), (int) size);
+        const char *bytes = nullptr;
+        size_t count = 0;
+        if (!ProtoTrivialField<T>::parse(&is, &bytes, &count) || count != 1)
+            return false;
+
+        ProtoTrivialField<T>::copy(&value, bytes, 1);
+        return true;
+    }
+};
+
+//
+// Generated by Protobuf
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_Proto> {
+public:
+    std::string serialize(const T &proto) const {
+        return proto.SerializeAsString();
+    }
+
+    size_t byteSize(const T &proto) const {
+        return proto.ByteSizeLong();
+    }
+
+    void serializeTo(const T &proto, ProtoWire::Output *os) const {
+        proto.SerializeWithCachedSizes(os);
+    }
+
+    bool deserialize(T &proto, const std::string &data) const {
+        return proto.ParseFromString(data);
+    }
+
+    bool deserialize(T &proto, const char *data, size_t size) const {
+        return proto.ParseFromArray(data, (int) size);
+    }
+};
+
+//
+// Sequence Container: vector, list, deque
+//
+template<typename T, typename Allocator, template<typename, typename> class Container>
+struct ProtoSerializerImpl<Container<T, Allocator>, kProtoType_Seq>
+        : public ProtoSeqSerializer<Container<T, Allocator>, ProtoSerializer> {
+};
+
+//
+// Set Container: set, multiset
+//
+template<typename Key, typename Compare, typename Allocator, template<typename, typename, typename> class Set>
+struct ProtoSerializerImpl<Set<Key, Compare, Allocator>, kProtoType_Set>
+        : public ProtoSetSerializer<Set<Key, Compare, Allocator>, ProtoSerializer> {
+};
+
+//
+// Map Container: map, multimap
+//
+template<typename Key, typename T, typename Compare, typename Allocator, template<typename, typename, typename, typename> class Map>
+struct ProtoSerializerImpl<Map<Key, T, Compare, Allocator>, kProtoType_Map>
+        : public ProtoMapSerializer<Map<Key, T, Compare, Allocator>, ProtoSerializer> {
+};
+
+//
+// Hash Set Container: unordered_set, unordered_multiset
+//
+template<typename Key, typename Hash, typename KeyEqual, typename Allocator, template<typename, typename, typename, typename> class Set>
+struct ProtoSerializerImpl<Set<Key, Hash, KeyEqual, Allocator>, kProtoType_HashSet>
+        : public ProtoSetSerializer<Set<Key, Hash, KeyEqual, Allocator>, ProtoSerializer> {
+};
+
+//
+// Hash Map Container: unordered_map, unordered_multimap
+//
+template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator,
+        template<typename, typename, typename, typename, typename> class Map>
+struct ProtoSerializerImpl<Map<Key, T, Hash, KeyEqual, Allocator>, kProtoType_HashMap>
+        : public ProtoMapSerializer<Map<Key, T, Hash, KeyEqual, Allocator>, ProtoSerializer> {
+};
+
+//
+// Array Container: std::array
+//
+template<typename T, size_t N>
+struct ProtoSerializerImpl<std::array<T, N>, kProtoType_Array>
+        : public ProtoArraySerializer<std::array<T, N>, ProtoSerializer> {
+};
+
+//
+// User Defined
+//
+template<typename T>
+struct ProtoSerializerImpl<T, kProtoType_UserDefined> {
+public:
+    std::string serialize(const T &object) const {
+        return object.serialize();
+    }
+
+    // only when T implements them
+    template<typename U = T>
+    auto byteSize(const U &object) const -> decltype(size_t(object.byteSize())) {
+        return object.byteSize();
+    }
+
+    void serializeTo(const T &object, ProtoWire::Output *os) const {
+        object.serializeTo(os);
+    }
+
+    bool deserialize(T &object, const std::string &data) const {
+        return object.deserialize(data);
+    }
+
+    // T::deserialize(const char *, size_t) when implemented, or a copy
+    bool deserialize(T &object, const char *data, size_t size) const {
+        return deserialize(object, data, size, 0);
+    }
+
+protected:
+    template<typename U = T>
+    auto deserialize(U &object, const char *data, size_t size, int) const
+    -> decltype(bool(object.deserialize(data, size))) {
+        return object.deserialize(data, size);
+    }
+
+    bool deserialize(T &object, const char *data, size_t size, long) const {
+        return object.deserialize(std::string(data, size));
     }
 };
 
@@ -97,295 +97,204 @@ struct ProtoDynSerializerImpl<T, kProtoType_Proto>
         : public ProtoSerializerImpl<T, kProtoType_Proto> {
 };
 
+//
+// Trivially Copyable: PROTO_CASE_TRIVIAL
+//
+template<typename T>
+struct ProtoDynSerializerImpl<T, kProtoType_Trivial>
+        : public ProtoSerializerImpl<T, kProtoType_Trivial> {
+};
+
 //
 // Sequence Container: vector, list, deque
 //
 template<typename T, typename Allocator, template<typename, typename> class Container>
-struct ProtoDynSerializerImpl<Container<T, Allocator>, kProtoType_Seq> {
-
-    std::string serialize(const Container<T, Allocator> &objects) const {
-        SequenceProto proto;
-        ProtoDynSerializer<T> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
-
-        return proto.SerializeAsString();
-    }
-
-    bool deserialize(Container<T, Allocator> &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoDynSerializer<T> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                T obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.push_back(obj);
-            }
-            return true;
-        }
-        return false;
-    }
+struct ProtoDynSerializerImpl<Container<T, Allocator>, kProtoType_Seq>
+        : public ProtoSeqSerializer<Container<T, Allocator>, ProtoDynSerializer> {
 };
 
 //
 // Set Container: set, multiset
 //
 template<typename Key, typename Compare, typename Allocator, template<typename, typename, typename> class Set>
-struct ProtoDynSerializerImpl<Set<Key, Compare, Allocator>, kProtoType_Set> {
-
-    typedef Set<Key, Compare, Allocator> SetType;
-
-    std::string serialize(const SetType &objects) const {
-        SequenceProto proto;
-        ProtoDynSerializer<Key> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
-
-        return proto.SerializeAsString();
-    }
-
-    bool deserialize(SetType &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoDynSerializer<Key> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.insert(obj);
-            }
-            return true;
-        }
-        return false;
-    }
+struct ProtoDynSerializerImpl<Set<Key, Compare, Allocator>, kProtoType_Set>
+        : public ProtoSetSerializer<Set<Key, Compare, Allocator>, ProtoDynSerializer> {
 };
 
 //
 // Map Container: map, multimap
 //
 template<typename Key, typename T, typename Compare, typename Allocator, template<typename, typename, typename, typename> class Map>
-struct ProtoDynSerializerImpl<Map<Key, T, Compare, Allocator>, kProtoType_Map> {
-    typedef Map<Key, T, Compare, Allocator> MapType;
-
-    std::string serialize(const MapType &objects) const {
-        AssociateProto proto;
-        ProtoDynSerializer<Key> key_serializer;
-        ProtoDynSerializer<T> value_serializer;
-        for (auto &v : objects) {
-            AssociateProto::ValueType *mem = proto.add_values();
-            if (mem) {
-                ArchiveMemberProto *key = mem->mutable_key();
-                ArchiveMemberProto *value = mem->mutable_value();
-                if (key && value) {
-                    key->set_data(key_serializer.serialize(v.first));
-                    value->set_data(value_serializer.serialize(v.second));
-                }
-            }
-        }
-
-        return proto.SerializeAsString();
-    }
-
-    bool deserialize(MapType &objects, const std::string &bin) const {
-        AssociateProto proto;
-        ProtoDynSerializer<Key> key_serializer;
-        ProtoDynSerializer<T> value_serializer;
-        if (proto.ParseFromString(bin)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key key;
-                T value;
-                if (key_serializer.deserialize(key, proto.values(i).key().data())
-                    && value_serializer.deserialize(value, proto.values(i).value().data())) {
-                    objects.insert(std::make_pair(key, value));
-                }
-            }
-            return true;
-        }
-        return false;
-    }
+struct ProtoDynSerializerImpl<Map<Key, T, Compare, Allocator>, kProtoType_Map>
+        : public ProtoMapSerializer<Map<Key, T, Compare, Allocator>, ProtoDynSerializer> {
 };
 
-
 //
 // Hash Set Container: unordered_set, unordered_multiset
 //
 template<typename Key, typename Hash, typename KeyEqual, typename Allocator, template<typename, typename, typename, typename> class Set>
-struct ProtoDynSerializerImpl<Set<Key, Hash, KeyEqual, Allocator>, kProtoType_HashSet> {
-
-    typedef Set<Key, Hash, KeyEqual, Allocator> SetType;
-
-    std::string serialize(const SetType &objects) const {
-        SequenceProto proto;
-        ProtoDynSerializer<Key> member_serializer;
-        for (auto &v : objects) {
-            ArchiveMemberProto *mem = proto.add_values();
-            if (mem) {
-                mem->set_data(member_serializer.serialize(v));
-            }
-        }
-
-        return proto.SerializeAsString();
-    }
-
-    bool deserialize(SetType &objects, const std::string &data) const {
-        SequenceProto proto;
-        ProtoDynSerializer<Key> member_serializer;
-        if (proto.ParseFromString(data)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key obj;
-                if (member_serializer.deserialize(obj, proto.values(i).data()))
-                    objects.insert(obj);
-            }
-            return true;
-        }
-        return false;
-    }
+struct ProtoDynSerializerImpl<Set<Key, Hash, KeyEqual, Allocator>, kProtoType_HashSet>
+        : public ProtoSetSerializer<Set<Key, Hash, KeyEqual, Allocator>, ProtoDynSerializer> {
 };
 
-
 //
 // Hash Map Container: unordered_map, unordered_multimap
 //
 template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator,
         template<typename, typename, typename, typename, typename> class Map>
-struct ProtoDynSerializerImpl<Map<Key, T, Hash, KeyEqual, Allocator>, kProtoType_HashMap> {
-    typedef Map<Key, T, Hash, KeyEqual, Allocator> MapType;
-
-    std::string serialize(const MapType &objects) const {
-        AssociateProto proto;
-        ProtoDynSerializer<Key> key_serializer;
-        ProtoDynSerializer<T> value_serializer;
-        for (auto &v : objects) {
-            AssociateProto::ValueType *mem = proto.add_values();
-            if (mem) {
-                ArchiveMemberProto *key = mem->mutable_key();
-                ArchiveMemberProto *value = mem->mutable_value();
-                if (key && value) {
-                    key->set_data(key_serializer.serialize(v.first));
-                    value->set_data(value_serializer.serialize(v.second));
-                }
-            }
-        }
-
-        return proto.SerializeAsString();
-    }
+struct ProtoDynSerializerImpl<Map<Key, T, Hash, KeyEqual, Allocator>, kProtoType_HashMap>
+        : public ProtoMapSerializer<Map<Key, T, Hash, KeyEqual, Allocator>, ProtoDynSerializer> {
+};
 
-    bool deserialize(MapType &objects, const std::string &bin) const {
-        AssociateProto proto;
-        ProtoDynSerializer<Key> key_serializer;
-        ProtoDynSerializer<T> value_serializer;
-        if (proto.ParseFromString(bin)) {
-            for (int i = 0; i < proto.values_size(); ++i) {
-                Key key;
-                T value;
-                if (key_serializer.deserialize(key, proto.values(i).key().data())
-                    && value_serializer.deserialize(value, proto.values(i).value().data())) {
-                    objects.insert(std::make_pair(key, value));
-                }
-            }
-            return true;
-        }
-        return false;
-    }
+//
+// Array Container: std::array
+//
+template<typename T, size_t N>
+struct ProtoDynSerializerImpl<std::array<T, N>, kProtoType_Array>
+        : public ProtoArraySerializer<std::array<T, N>, ProtoDynSerializer> {
 };
 
 //
 // User Defined
 //
+// The message of a mapping is a bytes field per property, keyed by its
+// number: encoded and decoded straight on the wire, identical to
+// protobuf's (fields by number, the last occurrence wins, unknown fields
+// skipped). Building with -DTINYSERIALIZER_DYN_REFLECTION=1 goes through
+// DynamicMessage and Reflection instead, on the thread's arena (see
+// ProtoArena). The descriptor, prototype and fields are cached by the mapping.
+//
+
 template<typename T>
 struct ProtoDynSerializerImpl<T, kProtoType_UserDefined> {
 public:
     std::string serialize(const T &object) const {
-        using namespace google::protobuf;
-        ProtoMapping<T> *mapping = ProtoMappingFactory::instance().template mappingByType<T>();
-        if (!mapping) {
-            throw ProtoSerializerException("%s : mapping is NULL", __PRETTY_FUNCTION__);
-            return "";
-        }
-
-        const Descriptor *descriptor = mapping->descriptorPool()->FindMessageTypeByName(mapping->protoName());
-        if (!descriptor) {
-            throw ProtoSerializerException("%s : descriptor is NULL", __PRETTY_FUNCTION__);
-            return "";
-        }
-
-        const Message *prototype = mapping->messageFactory()->GetPrototype(descriptor);
-        if (!prototype) {
-            throw ProtoSerializerException("%s : prototype is NULL", __PRETTY_FUNCTION__);
-            return "";
-        }
-
-        Message *proto = prototype->New();
-        const Reflection *refl = proto->GetReflection();
-        const Descriptor *desc = proto->GetDescriptor();
-        if (!refl || !desc) {
-            throw ProtoSerializerException("%s : reflection is NULL", __PRETTY_FUNCTION__);
-            return "";
-        }
+#if TINYSERIALIZER_DYN_REFLECTION
+        return reflectionSerialize(object);
+#else
+        return ProtoWire::toString(*this, object);
+#endif
+    }
 
+    void serializeTo(const T &object, ProtoWire::Output *os) const {
+        ProtoMapping<T> *mapping = this->mapping();
         try {
-            for (auto &cpp_prop : mapping->struct_->propertyIterator()) {
-                const FieldDescriptor *proto_fd = desc->FindFieldByName(cpp_prop->name());
-                if (proto_fd && FieldDescriptor::TYPE_BYTES == proto_fd->type()) {
-                    refl->SetString(proto, proto_fd, cpp_prop->serialize(object));
-                }
+            for (size_t i : mapping->wireOrder()) {
+                const typename ProtoMapping<T>::Field &field = mapping->fields()[i];
+                std::string bin = field.property->serialize(object);
+                os->WriteTag(ProtoWire::tag((uint32_t) field.descriptor->number()));
+                os->WriteVarint32((uint32_t) bin.size());
+                os->WriteRaw(bin.data(), (int) bin.size());
             }
         } catch (const std::exception &e) {
             throw ProtoSerializerException("%s : serialize error : %s", __PRETTY_FUNCTION__, e.what());
-            return "";
         }
+    }
 
-        return proto->SerializeAsString();
+    bool deserialize(T &object, const std::string &data) const {
+        return deserialize(object, data.data(), data.size());
     }
 
+    bool deserialize(T &object, const char *data, size_t size) const {
+#if TINYSERIALIZER_DYN_REFLECTION
+        return reflectionDeserialize(object, data, size);
+#else
+        ProtoMapping<T> *mapping = this->mapping();
+        size_t count = mapping->fields().size();
+
+        // the last occurrence of every field, absent ones are empty
+        struct View {
+            const char *data;
+            size_t size;
+        };
+        View local[32];
+        std::vector<View> more;
+        View *views = local;
+        if (count > 32) {
+            more.resize(count);
+            views = more.data();
+        }
+        std::fill(views, views + count, View{"", 0});
+
+        ProtoWire::Input is(reinterpret_cast<const uint8_t *>(data), (int) size);
+        while (uint32_t tag = is.ReadTag()) {
+            int index = mapping->fieldByNumber(tag >> 3);
+            bool ok = (index >= 0 && (tag & 7) == 2)
+                      ? ProtoWire::readBytes(&is, &views[index].data, &views[index].size)
+                      : google::protobuf::internal::WireFormatLite::SkipField(&is, tag);
+            if (!ok) {
+                throw ProtoSerializerException("%s : parse failed", __PRETTY_FUNCTION__);
+                return false;
+            }
+        }
 
-    bool deserialize(T &object, const std::string &data) const {
-//        std::cout << __PRETTY_FUNCTION__ << std::endl;
-        using namespace google::protobuf;
-        ProtoMapping<T> *mapping = ProtoMappingFactory::instance().template mappingByType<T>();
-        if (!mapping) {
-            throw ProtoSerializerException("%s : mapping is NULL", __PRETTY_FUNCTION__);
+        if (!is.ConsumedEntireMessage()) {
+            throw ProtoSerializerException("%s : parse failed", __PRETTY_FUNCTION__);
             return false;
         }
 
-        const Descriptor *descriptor = mapping->descriptorPool()->FindMessageTypeByName(mapping->protoName());
-        if (!descriptor) {
-            throw ProtoSerializerException("%s : descriptor is NULL", __PRETTY_FUNCTION__);
+        try {
+            for (size_t i = 0; i < count; ++i)
+                mapping->fields()[i].property->deserialize(object, views[i].data, views[i].size);
+        } catch (const std::exception &e) {
+            throw ProtoSerializerException("%s : deserialize error : %s", __PRETTY_FUNCTION__, e.what());
             return false;
         }
+        return true;
+#endif
+    }
+
+protected:
+    static ProtoMapping<T> *mapping() {
+        ProtoMapping<T> *mapping = ProtoMappingFactory::instance().template mappingByType<T>();
+        if (!mapping)
+            throw ProtoSerializerException("%s : mapping is NULL", __PRETTY_FUNCTION__);
 
-        const Message *prototype = mapping->messageFactory()->GetPrototype(descriptor);
-        if (!prototype) {
+        if (!mapping->prototype())
             throw ProtoSerializerException("%s : prototype is NULL", __PRETTY_FUNCTION__);
-            return false;
-        }
+        return mapping;
+    }
 
-        Message *proto = prototype->New();
+    //
+    // DynamicMessage
+    //
+    std::string reflectionSerialize(const T &object) const {
+        using namespace google::protobuf;
+        ProtoMapping<T> *mapping = this->mapping();
+
+        ProtoTempMessage message(mapping->prototype());
+        Message *proto = message.get();
         const Reflection *refl = proto->GetReflection();
-        const Descriptor *desc = proto->GetDescriptor();
-        if (!refl || !desc) {
-            throw ProtoSerializerException("%s : reflection is NULL", __PRETTY_FUNCTION__);
-            return false;
+
+        try {
+            for (auto &field : mapping->fields())
+                refl->SetString(proto, field.descriptor, field.property->serialize(object));
+        } catch (const std::exception &e) {
+            throw ProtoSerializerException("%s : serialize error : %s", __PRETTY_FUNCTION__, e.what());
+            return "";
         }
 
-        if (!proto->ParseFromString(data)) {
-            throw ProtoSerializerException("%s : ParseFromString failed", __PRETTY_FUNCTION__);
+        return proto->SerializeAsString();
+    }
+
+    bool reflectionDeserialize(T &object, const char *data, size_t size) const {
+        using namespace google::protobuf;
+        ProtoMapping<T> *mapping = this->mapping();
+
+        ProtoTempMessage message(mapping->prototype());
+        Message *proto = message.get();
+        const Reflection *refl = proto->GetReflection();
+
+        if (!proto->ParseFromArray(data, (int) size)) {
+            throw ProtoSerializerException("%s : ParseFromArray failed", __PRETTY_FUNCTION__);
             return false;
         }
 
         try {
-            for (auto &cpp_prop : mapping->struct_->propertyIterator()) {
-                const FieldDescriptor *proto_fd = desc->FindFieldByName(cpp_prop->name());
-                if (proto_fd && FieldDescriptor::TYPE_BYTES == proto_fd->type()) {
-                    cpp_prop->deserialize(object, refl->GetString(*proto, proto_fd));
-                }
+            std::string scratch;
+            for (auto &field : mapping->fields()) {
+                const std::string &bin = refl->GetStringReference(*proto, field.descriptor, &scratch);
+                field.property->deserialize(object, bin.data(), bin.size());
             }
         } catch (const std::exception &e) {
             throw ProtoSerializerException("%s : deserialize error : %s", __PRETTY_FUNCTION__, e.what());
@@ -395,7 +304,6 @@ public:
     }
 };
 
-
 TINY_NAMESPACE_END
 
 #endif //TINYWORLD_TINYSERIALIZER_PROTO_DYN_H
@@ -27,6 +27,7 @@
 
 #include "tinyworld.h"
 
+#include <algorithm>
 #include <ostream>
 #include <unordered_map>
 #include <vector>
@@ -152,7 +153,30 @@ public:
         }
 
         descriptor_pool_->BuildFile(file_proto);
-        return true;
+        return cache();
+    }
+
+    //
+    // Cached by createProtoDescriptor() for the serializers, NULL/empty before
+    //
+    struct Field {
+        Property<T> *property;
+        const google::protobuf::FieldDescriptor *descriptor;
+    };
+
+    const google::protobuf::Descriptor *descriptor() const { return descriptor_; }
+
+    const google::protobuf::Message *prototype() const { return prototype_; }
+
+    // the bytes fields of the properties, in order
+    const std::vector<Field> &fields() const { return fields_; }
+
+    // indexes of fields() by number: protobuf's serialization order
+    const std::vector<size_t> &wireOrder() const { return wire_order_; }
+
+    // index of a field number in fields(), -1 if none
+    int fieldByNumber(uint32_t number) const {
+        return number < field_by_number_.size() ? (int) field_by_number_[number] - 1 : -1;
     }
 
 
@@ -165,10 +189,49 @@ public:
 
     void done();
 
+protected:
+    bool cache() {
+        using namespace google::protobuf;
+
+        fields_.clear();
+        wire_order_.clear();
+        field_by_number_.clear();
+        descriptor_ = descriptor_pool_->FindMessageTypeByName(proto_name_);
+        prototype_ = (descriptor_ && message_factory_) ? message_factory_->GetPrototype(descriptor_) : nullptr;
+        if (!prototype_) return false;
+
+        for (auto &prop : struct_->propertyIterator()) {
+            const FieldDescriptor *fd = descriptor_->FindFieldByName(prop->name());
+            if (fd && FieldDescriptor::TYPE_BYTES == fd->type())
+                fields_.push_back(Field{prop.get(), fd});
+        }
+
+        // dense: the numbers are uint16_t
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            uint32_t number = (uint32_t) fields_[i].descriptor->number();
+            if (number >= field_by_number_.size())
+                field_by_number_.resize(number + 1, 0);
+            field_by_number_[number] = (uint16_t) (i + 1);
+            wire_order_.push_back(i);
+        }
+
+        std::sort(wire_order_.begin(), wire_order_.end(), [this](size_t a, size_t b) {
+            return fields_[a].descriptor->number() < fields_[b].descriptor->number();
+        });
+        return true;
+    }
+
 public:
     Struct<T> *struct_;
     bool from_struct_factory_;
     ProtoMappingFactory *factory_;
+
+protected:
+    const google::protobuf::Descriptor *descriptor_ = nullptr;
+    const google::protobuf::Message *prototype_ = nullptr;
+    std::vector<Field> fields_;
+    std::vector<size_t> wire_order_;
+    std::vector<uint16_t> field_by_number_;
 };
 
 
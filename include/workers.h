@@ -0,0 +1,114 @@
+#ifndef TINYWORLD_WORKERS_H
+#define TINYWORLD_WORKERS_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+//
+// Fixed number of worker threads for short background tasks (e.g. the
+// hedged reads), started on construction, joined on destruction.
+//
+//   WorkerPool workers(8);
+//   if (!workers.tryPost(task))
+//       task();                  // all the workers busy: do it in place
+//
+// tryPost() never queues a task behind a busy worker, so a posted task
+// starts at once or is refused. post() queues it, the number of threads
+// stays bounded whatever the load (e.g. the scatter-gather fan-out).
+// A task must not throw.
+//
+class WorkerPool {
+public:
+    typedef std::function<void()> Task;
+
+    explicit WorkerPool(size_t workers) {
+        for (size_t i = 0; i < workers; ++i)
+            threads_.push_back(std::thread([this]() { run(); }));
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+
+        for (auto &thread : threads_)
+            thread.join();
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // false: no idle worker
+    bool tryPost(const Task &task) {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (stopping_ || tasks_.size() >= idle_)
+                return false;
+            tasks_.push_back(task);
+        }
+        cond_.notify_one();
+        return true;
+    }
+
+    // run by the next free worker, false: stopping
+    bool post(const Task &task) {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (stopping_)
+                return false;
+            tasks_.push_back(task);
+        }
+        cond_.notify_one();
+        return true;
+    }
+
+    size_t size() const { return threads_.size(); }
+
+    size_t idle() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return idle_ > tasks_.size() ? idle_ - tasks_.size() : 0;
+    }
+
+    size_t queued() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return tasks_.size();
+    }
+
+protected:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            idle_++;
+            cond_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            idle_--;
+
+            if (tasks_.empty())
+                return;
+
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+private:
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Task> tasks_;
+    size_t idle_ = 0;
+    bool stopping_ = false;
+};
+
+#endif //TINYWORLD_WORKERS_H
@@ -1,4 +1,5 @@
 #include "hashkit.h"
+#include <string.h>
 
 /*
  * "Murmur" hash provided by Austin, tanjent@gmail.com
@@ -80,3 +81,328 @@ hash_murmur(const char *key, size_t length)
 
     return h;
 }
+
+/*
+ * Jump Consistent Hash
+ * "A Fast, Minimal Memory, Consistent Hash Algorithm", John Lamping, Eric Veach
+ */
+
+int32_t
+jump_consistent_hash(uint64_t key, int32_t buckets)
+{
+    int64_t b = -1, j = 0;
+
+    while (j < buckets) {
+        b = j;
+        key = key * 2862933555777941757ULL + 1;
+        j = (int64_t)((b + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+    }
+
+    return (int32_t)b;
+}
+
+/*
+ * Little-endian loads, unaligned-safe: the hashes below give the same
+ * results on every platform.
+ */
+
+static inline uint64_t
+read64(const unsigned char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint32_t
+read32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint64_t
+rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+/*
+ * xxHash64, Yann Collet
+ * https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ *
+ * Four independent lanes over 32-byte stripes, the compiler keeps them
+ * in registers and pipelines them.
+ */
+
+static const uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t
+xxh64_round(uint64_t acc, uint64_t input)
+{
+    acc += input * XXH_PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t
+xxh64_merge(uint64_t acc, uint64_t val)
+{
+    acc ^= xxh64_round(0, val);
+    return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t
+hash_xxh64(const char *key, size_t length, uint64_t seed)
+{
+    const unsigned char *p = (const unsigned char *)key;
+    const unsigned char *end = p + length;
+    uint64_t h;
+
+    if (length >= 32) {
+        const unsigned char *limit = end - 32;
+        uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+        uint64_t v2 = seed + XXH_PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - XXH_PRIME64_1;
+
+        do {
+            v1 = xxh64_round(v1, read64(p));
+            v2 = xxh64_round(v2, read64(p + 8));
+            v3 = xxh64_round(v3, read64(p + 16));
+            v4 = xxh64_round(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh64_merge(h, v1);
+        h = xxh64_merge(h, v2);
+        h = xxh64_merge(h, v3);
+        h = xxh64_merge(h, v4);
+    } else {
+        h = seed + XXH_PRIME64_5;
+    }
+
+    h += (uint64_t)length;
+
+    while (p + 8 <= end) {
+        h ^= xxh64_round(0, read64(p));
+        h = rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+        p += 8;
+    }
+
+    if (p + 4 <= end) {
+        h ^= (uint64_t)read32(p) * XXH_PRIME64_1;
+        h = rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        p += 4;
+    }
+
+    while (p < end) {
+        h ^= (*p) * XXH_PRIME64_5;
+        h = rotl64(h, 11) * XXH_PRIME64_1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= XXH_PRIME64_2;
+    h ^= h >> 29;
+    h *= XXH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+/*
+ * MurmurHash3_x64_128, Austin Appleby (public domain)
+ * https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+ */
+
+static inline uint64_t
+fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+void
+hash_murmur3_128(const char *key, size_t length, uint32_t seed, uint64_t out[2])
+{
+    const unsigned char *data = (const unsigned char *)key;
+    const size_t nblocks = length / 16;
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    for (size_t i = 0; i < nblocks; i++) {
+        uint64_t k1 = read64(data + i * 16);
+        uint64_t k2 = read64(data + i * 16 + 8);
+
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const unsigned char *tail = data + nblocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+
+    switch (length & 15) {
+    case 15: k2 ^= ((uint64_t)tail[14]) << 48; /* fall through */
+    case 14: k2 ^= ((uint64_t)tail[13]) << 40; /* fall through */
+    case 13: k2 ^= ((uint64_t)tail[12]) << 32; /* fall through */
+    case 12: k2 ^= ((uint64_t)tail[11]) << 24; /* fall through */
+    case 11: k2 ^= ((uint64_t)tail[10]) << 16; /* fall through */
+    case 10: k2 ^= ((uint64_t)tail[9]) << 8;   /* fall through */
+    case 9:
+        k2 ^= ((uint64_t)tail[8]);
+        k2 *= c2; k2 = rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        /* fall through */
+    case 8: k1 ^= ((uint64_t)tail[7]) << 56;   /* fall through */
+    case 7: k1 ^= ((uint64_t)tail[6]) << 48;   /* fall through */
+    case 6: k1 ^= ((uint64_t)tail[5]) << 40;   /* fall through */
+    case 5: k1 ^= ((uint64_t)tail[4]) << 32;   /* fall through */
+    case 4: k1 ^= ((uint64_t)tail[3]) << 24;   /* fall through */
+    case 3: k1 ^= ((uint64_t)tail[2]) << 16;   /* fall through */
+    case 2: k1 ^= ((uint64_t)tail[1]) << 8;    /* fall through */
+    case 1:
+        k1 ^= ((uint64_t)tail[0]);
+        k1 *= c1; k1 = rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        /* fall through */
+    default:
+        break;
+    };
+
+    h1 ^= (uint64_t)length;
+    h2 ^= (uint64_t)length;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    out[0] = h1;
+    out[1] = h2;
+}
+
+/*
+ * CRC32C (Castagnoli, iSCSI polynomial 0x82F63B78, reflected)
+ *
+ * The SSE4.2 crc32 instruction when the CPU has it (checked once at
+ * runtime), slicing-by-8 tables otherwise. Both give the same value.
+ */
+
+static uint32_t crc32c_table[8][256];
+
+static bool
+crc32c_init_table()
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; j++)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+        crc32c_table[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 8; t++)
+            crc32c_table[t][i] = (crc32c_table[t - 1][i] >> 8) ^ crc32c_table[0][crc32c_table[t - 1][i] & 0xff];
+    }
+    return true;
+}
+
+static uint32_t
+crc32c_soft(uint32_t crc, const unsigned char *p, size_t length)
+{
+    static bool ready = crc32c_init_table();
+    (void)ready;
+
+    while (length >= 8) {
+        uint64_t v = read64(p) ^ crc;
+        crc = crc32c_table[7][v & 0xff] ^
+              crc32c_table[6][(v >> 8) & 0xff] ^
+              crc32c_table[5][(v >> 16) & 0xff] ^
+              crc32c_table[4][(v >> 24) & 0xff] ^
+              crc32c_table[3][(v >> 32) & 0xff] ^
+              crc32c_table[2][(v >> 40) & 0xff] ^
+              crc32c_table[1][(v >> 48) & 0xff] ^
+              crc32c_table[0][v >> 56];
+        p += 8;
+        length -= 8;
+    }
+
+    while (length--)
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *p++) & 0xff];
+
+    return crc;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+
+__attribute__((target("sse4.2")))
+static uint32_t
+crc32c_sse42(uint32_t crc, const unsigned char *p, size_t length)
+{
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc64 = _mm_crc32_u64(crc64, v);
+        p += 8;
+        length -= 8;
+    }
+
+    crc = (uint32_t)crc64;
+    while (length--)
+        crc = _mm_crc32_u8(crc, *p++);
+
+    return crc;
+}
+
+static uint32_t (*crc32c_select())(uint32_t, const unsigned char *, size_t)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") ? crc32c_sse42 : crc32c_soft;
+}
+#else
+static uint32_t (*crc32c_select())(uint32_t, const unsigned char *, size_t)
+{
+    return crc32c_soft;
+}
+#endif
+
+uint32_t
+hash_crc32c(const char *key, size_t length, uint32_t crc)
+{
+    static uint32_t (*const impl)(uint32_t, const unsigned char *, size_t) = crc32c_select();
+    return ~impl(~crc, (const unsigned char *)key, length);
+}
+
+uint32_t
+hash_crc32c_soft(const char *key, size_t length, uint32_t crc)
+{
+    return ~crc32c_soft(~crc, (const unsigned char *)key, length);
+}
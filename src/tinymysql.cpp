@@ -2,14 +2,20 @@
 #include "tinylogger.h"
 #include "url.h"
 
+#include <map>
+#include <chrono>
+#include <algorithm>
+
 //////////////////////////////////////////////////////////////////////////
 
 MySqlConnection::MySqlConnection() {
     shard_ = -1;
+    replica_ = -1;
 }
 
 MySqlConnection::MySqlConnection(const std::string &url) {
     shard_ = -1;
+    replica_ = -1;
     connectByURL(url);
 }
 
@@ -32,6 +38,12 @@ bool MySqlConnection::connectByURL(const std::string &urltext) {
             shard_ = atol(url.query["shard"].c_str());
         }
 
+        if (url.query["replica"].size() > 0) {
+            replica_ = atol(url.query["replica"].c_str());
+        }
+
+        url_ = urltext;
+
         LOG_INFO("mysql", "connect %s success", urltext.c_str());
     }
     catch (std::exception &er) {
@@ -44,9 +56,31 @@ bool MySqlConnection::connectByURL(const std::string &urltext) {
 
 //////////////////////////////////////////////////////////////////////////
 
+static uint64_t next_pool_id() {
+    static std::atomic<uint64_t> id(0);
+    return ++id;
+}
+
 MySqlConnectionPool::MySqlConnectionPool() {
     wait_timeout_ = 28800; // MySQL default:8hours
     shard_ = -1;
+    read_policy_ = kReadPolicy_RoundRobin;
+    max_lag_ = 10;
+    lag_interval_ = 1000;
+    ryw_window_ = 1000;
+    lag_ = 0;
+    round_ = 0;
+    last_check_ = 0;
+    hedge_ = false;
+    id_ = next_pool_id();
+
+    // constructed before the first pool, so destroyed after the last one
+    MySqlWatchdog::instance();
+    MySqlPoolMaintainer::instance().add(this);
+}
+
+MySqlConnectionPool::~MySqlConnectionPool() {
+    MySqlPoolMaintainer::instance().remove(this);
 }
 
 void MySqlConnectionPool::setServerAddress(const std::string &urltext) {
@@ -69,6 +103,74 @@ void MySqlConnectionPool::setServerAddress(const std::string &urltext) {
             if (maxconn > 0)
                 setMaxConn(maxconn);
         }
+
+        if (url.query["reserved"].size() > 0) {
+            setHighReserved(atol(url.query["reserved"].c_str()));
+        }
+
+        // minconn < maxconn : the pool size adapts between them
+        if (url.query["minconn"].size() > 0) {
+            unsigned int minconn = atol(url.query["minconn"].c_str());
+            if (minconn > 0 && minconn < maxConn()) {
+                PoolAdaptivePolicy policy;
+                policy.enabled = true;
+                policy.min_conns = minconn;
+                policy.max_conns = maxConn();
+                setAdaptivePolicy(policy);
+            }
+        }
+
+        if (url.query["readpolicy"] == "leastloaded") {
+            read_policy_ = kReadPolicy_LeastLoaded;
+        }
+
+        if (url.query["maxlag"].size() > 0) {
+            max_lag_ = atol(url.query["maxlag"].c_str());
+        }
+
+        if (url.query["lagcheck"].size() > 0) {
+            lag_interval_ = atol(url.query["lagcheck"].c_str());
+        }
+
+        if (url.query["ryw"].size() > 0) {
+            ryw_window_ = atol(url.query["ryw"].c_str());
+        }
+
+        if (url.query["breaker"].size() > 0) {
+            breaker_.setThreshold(atol(url.query["breaker"].c_str()));
+        }
+
+        if (url.query["breakertime"].size() > 0) {
+            breaker_.setOpenTime(atol(url.query["breakertime"].c_str()));
+        }
+
+        if (url.query["hedge"].size() > 0) {
+            hedge_ = atol(url.query["hedge"].c_str()) != 0;
+        }
+
+        // replicas: same url with the replica's host:port
+        std::string replicas = url.query["replicas"];
+        if (replicas.size() > 0) {
+            TinyURL replica = url;
+            replica.query.erase("replicas");
+
+            size_t begin = 0;
+            while (begin < replicas.size()) {
+                size_t end = replicas.find(',', begin);
+                if (end == std::string::npos)
+                    end = replicas.size();
+
+                std::string address = replicas.substr(begin, end - begin);
+                begin = end + 1;
+                if (address.empty()) continue;
+
+                size_t colon = address.find(':');
+                replica.host = address.substr(0, colon);
+                replica.port = (colon != std::string::npos ? atol(address.substr(colon + 1).c_str()) : url.port);
+                replica.query["replica"] = std::to_string(replicas_.size());
+                addReplica(replica.make());
+            }
+        }
     }
 }
 
@@ -86,8 +188,357 @@ mysqlpp::Connection *MySqlConnectionPool::create() {
 }
 
 
+static int64_t steady_milliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//
+// pool id -> until when the calling thread reads from the pool's primary.
+// Ids are never reused, the expired entries (of destroyed pools too) are
+// dropped once the map grows.
+//
+static std::map<uint64_t, int64_t> &read_your_writes() {
+    static thread_local std::map<uint64_t, int64_t> writes;
+    return writes;
+}
+
+bool MySqlConnectionPool::addReplica(const std::string &url) {
+    std::unique_ptr<MySqlConnectionPool> replica(new MySqlConnectionPool());
+    replica->setServerAddress(url);
+    if (replica->replicaCount() > 0) {
+        LOG_ERROR("mysql", "add replica %s failed: a replica can't have replicas", url.c_str());
+        return false;
+    }
+
+    replicas_.push_back(std::move(replica));
+    return true;
+}
+
+std::vector<MySqlConnectionPool *> MySqlConnectionPool::readPools(size_t max) {
+    std::vector<MySqlConnectionPool *> pools;
+    if (replicas_.empty())
+        return std::vector<MySqlConnectionPool *>(1, this);
+
+    // read your writes
+    if (recentlyWritten())
+        return std::vector<MySqlConnectionPool *>(1, this);
+
+    size_t count = replicas_.size();
+    size_t start = round_++;
+    for (size_t i = 0; i < count; ++i) {
+        MySqlConnectionPool *replica = replicas_[(start + i) % count].get();
+        int lag = replica->lag();
+        if (lag >= 0 && lag <= max_lag_ && replica->breaker().available())
+            pools.push_back(replica);
+    }
+
+    if (read_policy_ == kReadPolicy_LeastLoaded) {
+        std::vector<std::pair<unsigned int, MySqlConnectionPool *>> loads;
+        for (auto pool : pools)
+            loads.push_back(std::make_pair(pool->stats().in_use, pool));
+
+        std::stable_sort(loads.begin(), loads.end(),
+                         [](const std::pair<unsigned int, MySqlConnectionPool *> &a,
+                            const std::pair<unsigned int, MySqlConnectionPool *> &b) {
+                             return a.first < b.first;
+                         });
+        for (size_t i = 0; i < loads.size(); ++i)
+            pools[i] = loads[i].second;
+    }
+
+    // no replica in sync: the primary
+    if (pools.empty())
+        pools.push_back(this);
+
+    if (max && pools.size() > max)
+        pools.resize(max);
+    return pools;
+}
+
+bool MySqlConnectionPool::recentlyWritten() {
+    if (replicas_.empty() || !ryw_window_)
+        return false;
+
+    std::map<uint64_t, int64_t> &writes = read_your_writes();
+    auto it = writes.find(id_);
+    return it != writes.end() && steady_milliseconds() < it->second;
+}
+
+void MySqlConnectionPool::markWritten() {
+    if (replicas_.empty() || !ryw_window_)
+        return;
+
+    int64_t now = steady_milliseconds();
+    std::map<uint64_t, int64_t> &writes = read_your_writes();
+    if (writes.size() >= kMaxReadYourWrites) {
+        for (auto it = writes.begin(); it != writes.end();) {
+            if (it->second <= now)
+                it = writes.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    writes[id_] = now + ryw_window_;
+}
+
+void MySqlConnectionPool::checkReplicas() {
+    for (auto &replica : replicas_) {
+        int lag = -1;
+
+        // never waits for a busy replica: checked again next time, the last lag stays
+        mysqlpp::Connection *conn = replica->tryAcquire(kPoolPriority_Low);
+        if (!conn)
+            continue;
+
+        try {
+            mysqlpp::Query query = conn->query();
+            query << "SHOW SLAVE STATUS";
+            mysqlpp::StoreQueryResult res = query.store();
+            if (res && res.num_rows() > 0) {
+                const mysqlpp::String &seconds = res[0]["Seconds_Behind_Master"];
+                if (!seconds.is_null())
+                    lag = atol(seconds.c_str());
+            }
+        }
+        catch (std::exception &err) {
+            LOG_ERROR("mysql", "check replica %s: %s", replica->url().c_str(), err.what());
+        }
+        replica->putback(conn);
+
+        if (lag < 0 || lag > max_lag_) {
+            LOG_WARN("mysql", "replica %s lag=%d, not read", replica->url().c_str(), lag);
+        }
+        replica->lag_ = lag;
+    }
+}
+
+void MySqlConnectionPool::release(const mysqlpp::Connection *pc) {
+    const MySqlConnection *conn = dynamic_cast<const MySqlConnection *>(pc);
+    if (conn && conn->replica() >= 0 && (size_t) conn->replica() < replicas_.size()) {
+        replicas_[conn->replica()]->release(pc);
+        return;
+    }
+
+    ConnectionPoolWithLimit::release(pc);
+}
+
+
+void MySqlConnectionPool::maintain() {
+    adjust();
+
+    // SHOW SLAVE STATUS may stall on a dead replica, never in a reader
+    int64_t now = steady_milliseconds();
+    if (!replicas_.empty() && now - last_check_ >= lag_interval_) {
+        last_check_ = now;
+        checkReplicas();
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+
+MySqlPoolMaintainer &MySqlPoolMaintainer::instance() {
+    static MySqlPoolMaintainer maintainer;
+    return maintainer;
+}
+
+MySqlPoolMaintainer::MySqlPoolMaintainer() {
+    current_ = NULL;
+    stopping_ = false;
+}
+
+MySqlPoolMaintainer::~MySqlPoolMaintainer() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+        cond_.notify_all();
+    }
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void MySqlPoolMaintainer::add(MySqlConnectionPool *pool) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    pools_.push_back(pool);
+    if (!thread_.joinable())
+        thread_ = std::thread([this]() { run(); });
+}
+
+void MySqlPoolMaintainer::remove(MySqlConnectionPool *pool) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    pools_.erase(std::remove(pools_.begin(), pools_.end(), pool), pools_.end());
+
+    // not skipped once removed: the maintain() in progress must finish
+    cond_.wait(lock, [this, pool]() { return current_ != pool; });
+}
+
+void MySqlPoolMaintainer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cond_.wait_for(lock, std::chrono::milliseconds(kInterval), [this]() { return stopping_; })) {
+        // maintain() runs unlocked, a slow pool doesn't hold up the others
+        // nor the pools created and destroyed meanwhile
+        std::vector<MySqlConnectionPool *> pools = pools_;
+        for (auto pool : pools) {
+            if (stopping_)
+                break;
+
+            // removed while another one was maintained
+            if (std::find(pools_.begin(), pools_.end(), pool) == pools_.end())
+                continue;
+
+            current_ = pool;
+            lock.unlock();
+            try {
+                pool->maintain();
+            }
+            catch (std::exception &err) {
+                LOG_ERROR("mysql", "maintain pool %s: %s", pool->url().c_str(), err.what());
+            }
+            lock.lock();
+
+            current_ = NULL;
+            cond_.notify_all();
+        }
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+
+MySqlWatchdog &MySqlWatchdog::instance() {
+    static MySqlWatchdog watchdog;
+    return watchdog;
+}
+
+MySqlWatchdog::MySqlWatchdog() {
+    next_id_ = 1;
+    kills_ = 0;
+    stopping_ = false;
+}
+
+MySqlWatchdog::~MySqlWatchdog() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+        cond_.notify_all();
+    }
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+uint64_t MySqlWatchdog::watch(MySqlConnection *conn, unsigned int ms) {
+    if (!conn || !ms || conn->url().empty())
+        return 0;
+
+    Watch watch;
+    watch.url = conn->url();
+    watch.thread_id = conn->thread_id();
+    watch.deadline = Clock::now() + std::chrono::milliseconds(ms);
+    watch.state = kWatch_Running;
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!thread_.joinable())
+        thread_ = std::thread([this]() { run(); });
+
+    uint64_t id = next_id_++;
+    watches_[id] = watch;
+    cond_.notify_all();
+    return id;
+}
+
+bool MySqlWatchdog::unwatch(uint64_t id) {
+    if (!id) return false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::map<uint64_t, Watch>::iterator it = watches_.find(id);
+    if (it == watches_.end())
+        return false;
+
+    // the KILL must not hit the connection's next statement
+    cond_.wait(lock, [this, id]() { return watches_[id].state != kWatch_Killing; });
+
+    bool killed = (watches_[id].state == kWatch_Killed);
+    watches_.erase(id);
+    return killed;
+}
+
+void MySqlWatchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point next = now + std::chrono::seconds(1);
+        bool killed = false;
+
+        for (std::map<uint64_t, Watch>::iterator it = watches_.begin(); it != watches_.end(); ++it) {
+            Watch &watch = it->second;
+            if (watch.state != kWatch_Running)
+                continue;
+
+            if (watch.deadline > now) {
+                next = std::min(next, watch.deadline);
+                continue;
+            }
+
+            watch.state = kWatch_Killing;
+            std::string url = watch.url;
+            unsigned long thread_id = watch.thread_id;
+            uint64_t id = it->first;
+
+            lock.unlock();
+            bool ok = kill(url, thread_id);
+            lock.lock();
+
+            LOG_WARN("mysql", "statement deadline passed: KILL QUERY %lu %s", thread_id, ok ? "OK" : "FAILED");
+            watches_[id].state = kWatch_Killed;
+            kills_++;
+            cond_.notify_all();
+
+            // the map may have changed while unlocked, scan again
+            killed = true;
+            break;
+        }
+
+        if (!killed)
+            cond_.wait_until(lock, next);
+    }
+}
+
+bool MySqlWatchdog::kill(const std::string &url, unsigned long thread_id) {
+    std::unique_ptr<MySqlConnection> &side = sides_[url];
+    if (!side || !side->connected())
+        side.reset(new MySqlConnection(url));
+
+    try {
+        mysqlpp::Query query = side->query();
+        query << "KILL QUERY " << thread_id;
+        if (query.exec(query.str()))
+            return true;
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("mysql", "KILL QUERY %lu: %s", thread_id, err.what());
+    }
+
+    // reconnect next time
+    side.reset();
+    return false;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 
+MySqlShardingPool::MySqlShardingPool(int shardnum) {
+    // the pools are destroyed with this one, maybe a static at exit: the
+    // singletons they use must outlive it
+    MySqlWatchdog::instance();
+    MySqlPoolMaintainer::instance();
+
+    Base::setShardNum(shardnum);
+}
+
 MySqlShardingPool *MySqlShardingPool::instance() {
     static MySqlShardingPool shardingpool;
     return &shardingpool;
@@ -102,12 +553,9 @@ bool MySqlShardingPool::init() {
 }
 
 void MySqlShardingPool::fini() {
-    for (Base::Shards::iterator it = shards_.begin(); it != shards_.end(); ++it) {
-        delete it->second;
-        it->second = NULL;
-    }
-
-    shards_.clear();
+    Base::Shards shards = clearShards();
+    for (Base::Shards::iterator it = shards.begin(); it != shards.end(); ++it)
+        delete *it;
 }
 
 bool MySqlShardingPool::addShardings(const std::vector<std::string> &urls) {
@@ -121,6 +569,31 @@ bool MySqlShardingPool::addShardings(const std::vector<std::string> &urls) {
     return true;
 }
 
+void MySqlShardingPool::dualWriteFailed(const std::string &table, const std::string &key) {
+    std::lock_guard<std::mutex> guard(dual_mutex_);
+    if (!isMigrating()) {
+        LOG_ERROR("mysql", "dual-write %s key=%s failed after the switch, the owner may be stale",
+                  table.c_str(), key.c_str());
+        return;
+    }
+
+    dual_failures_[table].insert(key);
+}
+
+MySqlShardingPool::KeysByTable MySqlShardingPool::takeDualWriteFailures() {
+    std::lock_guard<std::mutex> guard(dual_mutex_);
+    KeysByTable failures;
+    failures.swap(dual_failures_);
+    return failures;
+}
+
+bool MySqlShardingPool::commitMigrationIfClean() {
+    std::lock_guard<std::mutex> guard(dual_mutex_);
+    if (!dual_failures_.empty())
+        return false;
+    return commitMigration();
+}
+
 bool MySqlShardingPool::addSharding(const std::string &url) {
     MySqlConnectionPool *pool = new MySqlConnectionPool();
     if (!pool) {
@@ -0,0 +1,661 @@
+#include "tinymysql_resharding.h"
+#include "tinylogger.h"
+
+#include <sstream>
+#include <map>
+#include <set>
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////////
+
+MySqlResharding::MySqlResharding(MySqlShardingPool *pool, int shardnum)
+        : pool_(pool), new_shardnum_(shardnum) {
+    old_shardnum_ = pool_ ? pool_->shardNum() : 0;
+    state_ = kState_Idle;
+    stopping_ = false;
+}
+
+MySqlResharding::~MySqlResharding() {
+    stop();
+    wait();
+}
+
+bool MySqlResharding::addTable(const std::string &name,
+                               const std::string &pkey,
+                               const std::string &shardkey,
+                               const std::string &fields,
+                               bool embedded) {
+    if (embedded) {
+        LOG_INFO("resharding", "addTable %s skipped: routed by the embedded shard of %s, never moves",
+                 name.c_str(), shardkey.c_str());
+        return true;
+    }
+
+    Table table;
+    table.name = name;
+    table.pkey = pkey;
+    table.shardkey = shardkey;
+    table.pkey_index = table.shardkey_index = (size_t) -1;
+
+    std::istringstream is(fields);
+    std::string field;
+    while (std::getline(is, field, ',')) {
+        field.erase(0, field.find_first_not_of(" \t"));
+        field.erase(field.find_last_not_of(" \t") + 1);
+        if (field.empty()) continue;
+
+        if (field == pkey)
+            table.pkey_index = table.fields.size();
+        if (field == shardkey)
+            table.shardkey_index = table.fields.size();
+        table.fields.push_back(field);
+    }
+
+    if (table.pkey_index == (size_t) -1 || table.shardkey_index == (size_t) -1) {
+        LOG_ERROR("resharding", "addTable %s failed: fields must contain %s and %s",
+                  name.c_str(), pkey.c_str(), shardkey.c_str());
+        return false;
+    }
+
+    tables_.push_back(table);
+    return true;
+}
+
+MySqlResharding::Progress MySqlResharding::progress() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return progress_;
+}
+
+bool MySqlResharding::start() {
+    if (thread_.joinable())
+        return false;
+
+    thread_ = std::thread([this]() { run(); });
+    return true;
+}
+
+void MySqlResharding::wait() {
+    if (thread_.joinable())
+        thread_.join();
+}
+
+bool MySqlResharding::run() {
+    if (!pool_ || new_shardnum_ <= 0 || tables_.empty()) {
+        state_ = kState_Failed;
+        return false;
+    }
+
+    // 1. begin : dual write from now on
+    if (!pool_->beginMigration(new_shardnum_)) {
+        LOG_ERROR("resharding", "begin migration %d -> %d failed: not migrating, and all new shards added ?",
+                  old_shardnum_, new_shardnum_);
+        state_ = kState_Failed;
+        return false;
+    }
+
+    LOG_INFO("resharding", "begin migration %d -> %d", old_shardnum_, new_shardnum_);
+
+    // left by an earlier window, aborted
+    pool_->takeDualWriteFailures();
+
+    // 2. copy
+    state_ = kState_Copying;
+    for (auto &table : tables_) {
+        for (int shard = 0; shard < old_shardnum_; shard++) {
+            if (!copyTable(table, shard)) {
+                LOG_ERROR("resharding", "copy %s@%d failed, migration aborted", table.name.c_str(), shard);
+                pool_->abortMigration();
+                state_ = kState_Failed;
+                return false;
+            }
+        }
+    }
+
+    // 3. verify until clean
+    state_ = kState_Verifying;
+    unsigned long mismatched = 0;
+    for (unsigned int round = 0; round < verify_rounds_; round++) {
+        mismatched = 0;
+        for (auto &table : tables_) {
+            for (int shard = 0; shard < old_shardnum_ && !stopping_; shard++)
+                mismatched += verifyTable(table, shard);
+
+            // deleted after copied: the deletion went to both, the copy resurrected it
+            for (int shard = 0; shard < new_shardnum_ && !stopping_; shard++)
+                mismatched += verifyOrphans(table, shard);
+        }
+
+        LOG_INFO("resharding", "verify round %u: %lu rows mismatched", round, mismatched);
+        if (!mismatched || stopping_)
+            break;
+    }
+
+    if (mismatched || stopping_) {
+        LOG_ERROR("resharding", "verify failed (%lu rows mismatched), migration aborted", mismatched);
+        pool_->abortMigration();
+        state_ = kState_Failed;
+        return false;
+    }
+
+    // 4. switch routing, once the dual-writes failed meanwhile are repaired
+    bool switched = false;
+    for (unsigned int round = 0; round < verify_rounds_ && !switched && !stopping_; round++) {
+        if (repairDualWrites())
+            switched = pool_->commitMigrationIfClean();
+    }
+
+    if (!switched) {
+        LOG_ERROR("resharding", "failed dual-writes not repaired, migration aborted");
+        pool_->abortMigration();
+        state_ = kState_Failed;
+        return false;
+    }
+
+    state_ = kState_Switched;
+    LOG_INFO("resharding", "switched to %d shards", new_shardnum_);
+
+    // 5. purge the moved rows
+    if (purge_) {
+        for (auto &table : tables_) {
+            for (int shard = 0; shard < old_shardnum_ && !stopping_; shard++)
+                purgeTable(table, shard);
+        }
+    }
+
+    state_ = kState_Done;
+    return true;
+}
+
+bool MySqlResharding::copyTable(const Table &table, int shard) {
+    Cursor cursor;
+    while (!cursor.done) {
+        if (stopping_)
+            return false;
+
+        Rows rows;
+        {
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            if (!conn || !readChunk(&*conn, table, cursor, rows))
+                return false;
+        }
+
+        std::map<int, Rows> moved;
+        for (auto &row : rows) {
+            std::string key(row[table.shardkey_index].data(), row[table.shardkey_index].length());
+            int owner = pool_->movingShardIDByKey(key, shard);
+            if (owner >= 0)
+                moved[owner].push_back(row);
+        }
+
+        for (auto &v : moved) {
+            // rows already dual-written are newer, keep them
+            if (!writeRows(v.first, table, v.second, false))
+                return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            progress_.chunks++;
+            progress_.rows_scanned += rows.size();
+            for (auto &v : moved)
+                progress_.rows_copied += v.second.size();
+        }
+
+        throttle();
+    }
+
+    return true;
+}
+
+unsigned long MySqlResharding::verifyTable(const Table &table, int shard) {
+    std::ostringstream select;
+    select << "`" << table.pkey << "`,`" << table.shardkey << "`," << checksumColumn(table);
+
+    unsigned long mismatched = 0;
+    Cursor cursor;
+    while (!cursor.done && !stopping_) {
+        Rows rows;
+        {
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            if (!conn || !readChunk(&*conn, table, cursor, rows, select.str()))
+                return mismatched + 1;
+        }
+
+        // new owner -> (key -> checksum)
+        std::map<int, std::map<std::string, std::string> > moved;
+        for (auto &row : rows) {
+            std::string key(row[1].data(), row[1].length());
+            int owner = pool_->movingShardIDByKey(key, shard);
+            if (owner >= 0)
+                moved[owner][std::string(row[0].data(), row[0].length())] = std::string(row[2].data(),
+                                                                                        row[2].length());
+        }
+
+        for (auto &v : moved) {
+            std::vector<std::string> keys;
+            for (auto &kv : v.second)
+                keys.push_back(kv.first);
+
+            Rows copied;
+            {
+                MySqlConnectionByShard conn(v.first, pool_, kPoolPriority_Low);
+                if (!conn || !readRowsByKeys(&*conn, table, keys, copied, select.str()))
+                    return mismatched + 1;
+            }
+
+            std::map<std::string, std::string> checksums;
+            for (auto &row : copied)
+                checksums[std::string(row[0].data(), row[0].length())] = std::string(row[2].data(), row[2].length());
+
+            std::vector<std::string> bad;
+            for (auto &kv : v.second) {
+                auto it = checksums.find(kv.first);
+                if (it == checksums.end() || it->second != kv.second)
+                    bad.push_back(kv.first);
+            }
+
+            if (bad.empty())
+                continue;
+
+            // copy the fresh rows again
+            Rows fresh;
+            {
+                MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+                if (!conn || !readRowsByKeys(&*conn, table, bad, fresh))
+                    return mismatched + bad.size();
+            }
+
+            bool fixed = writeRows(v.first, table, fresh, true);
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            progress_.rows_mismatched += bad.size();
+            if (fixed)
+                progress_.rows_fixed += fresh.size();
+            mismatched += bad.size();
+        }
+
+        throttle();
+    }
+
+    return mismatched;
+}
+
+unsigned long MySqlResharding::verifyOrphans(const Table &table, int shard) {
+    std::ostringstream select;
+    select << "`" << table.pkey << "`,`" << table.shardkey << "`";
+
+    unsigned long orphaned = 0;
+    Cursor cursor;
+    while (!cursor.done && !stopping_) {
+        Rows rows;
+        {
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            if (!conn || !readChunk(&*conn, table, cursor, rows, select.str()))
+                return orphaned + 1;
+        }
+
+        // old owner -> keys moved to this shard
+        std::map<int, std::vector<std::string> > moved;
+        for (auto &row : rows) {
+            std::string key(row[1].data(), row[1].length());
+            int owner = pool_->shardIDByKey(key);
+            if (owner >= 0 && owner != shard && pool_->nextShardIDByKey(key) == shard)
+                moved[owner].push_back(std::string(row[0].data(), row[0].length()));
+        }
+
+        for (auto &v : moved) {
+            Rows present;
+            {
+                MySqlConnectionByShard conn(v.first, pool_, kPoolPriority_Low);
+                if (!conn || !readRowsByKeys(&*conn, table, v.second, present, select.str()))
+                    return orphaned + v.second.size();
+            }
+
+            std::set<std::string> keys;
+            for (auto &row : present)
+                keys.insert(std::string(row[0].data(), row[0].length()));
+
+            std::vector<std::string> gone;
+            for (auto &key : v.second) {
+                if (!keys.count(key))
+                    gone.push_back(key);
+            }
+
+            if (gone.empty())
+                continue;
+
+            //
+            // the ORM writes the owner before the new owner, so a row read
+            // here is on the old owner already unless deleted there. Asked
+            // again anyway: a write of another writer may still be landing.
+            //
+            Rows again;
+            {
+                MySqlConnectionByShard conn(v.first, pool_, kPoolPriority_Low);
+                if (!conn || !readRowsByKeys(&*conn, table, gone, again, select.str()))
+                    return orphaned + gone.size();
+            }
+
+            keys.clear();
+            for (auto &row : again)
+                keys.insert(std::string(row[0].data(), row[0].length()));
+            gone.erase(std::remove_if(gone.begin(), gone.end(), [&keys](const std::string &key) {
+                return keys.count(key) > 0;
+            }), gone.end());
+
+            if (gone.empty())
+                continue;
+
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            bool deleted = conn && deleteRows(&*conn, table, gone);
+
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (deleted)
+                progress_.rows_orphaned += gone.size();
+            orphaned += gone.size();
+        }
+
+        throttle();
+    }
+
+    return orphaned;
+}
+
+bool MySqlResharding::purgeTable(const Table &table, int shard) {
+    std::ostringstream select;
+    select << "`" << table.pkey << "`,`" << table.shardkey << "`";
+
+    Cursor cursor;
+    while (!cursor.done && !stopping_) {
+        Rows rows;
+        {
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            if (!conn || !readChunk(&*conn, table, cursor, rows, select.str()))
+                return false;
+        }
+
+        // owner -> keys
+        std::map<int, std::vector<std::string> > moved;
+        for (auto &row : rows) {
+            std::string key(row[1].data(), row[1].length());
+            int owner = pool_->shardIDByKey(key);
+            if (owner >= 0 && owner != shard)
+                moved[owner].push_back(std::string(row[0].data(), row[0].length()));
+        }
+
+        // only the rows the owner has, a row not routed by the key is kept
+        std::vector<std::string> keys;
+        size_t candidates = 0;
+        for (auto &v : moved) {
+            candidates += v.second.size();
+
+            Rows present;
+            MySqlConnectionByShard conn(v.first, pool_, kPoolPriority_Low);
+            if (!conn || !readRowsByKeys(&*conn, table, v.second, present, select.str()))
+                return false;
+
+            for (auto &row : present)
+                keys.push_back(std::string(row[0].data(), row[0].length()));
+        }
+
+        if (keys.size() < candidates)
+            LOG_WARN("resharding", "purge %s@%d: %lu rows missing on their owner are kept",
+                     table.name.c_str(), shard, (unsigned long) (candidates - keys.size()));
+
+        {
+            MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+            if (!conn || !deleteRows(&*conn, table, keys))
+                return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            progress_.rows_purged += keys.size();
+        }
+
+        throttle();
+    }
+
+    return true;
+}
+
+bool MySqlResharding::repairDualWrites() {
+    MySqlShardingPool::KeysByTable failures = pool_->takeDualWriteFailures();
+
+    bool ok = true;
+    for (auto &it : failures) {
+        auto table = std::find_if(tables_.begin(), tables_.end(), [&it](const Table &t) {
+            return t.name == it.first;
+        });
+        if (table == tables_.end()) {
+            LOG_WARN("resharding", "%lu failed dual-writes of %s: table not migrated, ignored",
+                     (unsigned long) it.second.size(), it.first.c_str());
+            continue;
+        }
+
+        LOG_INFO("resharding", "repair %s: %lu failed dual-writes", it.first.c_str(), (unsigned long) it.second.size());
+        if (!repairKeys(*table, it.second)) {
+            // recorded again for the next round
+            for (auto &key : it.second)
+                pool_->dualWriteFailed(it.first, key);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+bool MySqlResharding::repairKeys(const Table &table, const std::set<std::string> &keys) {
+    // (owner, new owner) -> shard keys
+    std::map<std::pair<int, int>, std::vector<std::string> > groups;
+    for (auto &key : keys) {
+        int ids[2];
+        if (pool_->writeShardIDsByKey(key, ids) == 2)
+            groups[std::make_pair(ids[0], ids[1])].push_back(key);
+    }
+
+    std::ostringstream select;
+    select << "`" << table.pkey << "`";
+
+    for (auto &group : groups) {
+        Rows rows, copied;
+        {
+            MySqlConnectionByShard conn(group.first.first, pool_, kPoolPriority_Low);
+            if (!conn || !readRowsByColumn(&*conn, table, table.shardkey, group.second, rows))
+                return false;
+        }
+
+        {
+            MySqlConnectionByShard conn(group.first.second, pool_, kPoolPriority_Low);
+            if (!conn || !readRowsByColumn(&*conn, table, table.shardkey, group.second, copied, select.str()))
+                return false;
+        }
+
+        std::set<std::string> present;
+        for (auto &row : rows)
+            present.insert(std::string(row[table.pkey_index].data(), row[table.pkey_index].length()));
+
+        std::vector<std::string> gone;
+        for (auto &row : copied) {
+            std::string pkey(row[0].data(), row[0].length());
+            if (!present.count(pkey))
+                gone.push_back(pkey);
+        }
+
+        if (!writeRows(group.first.second, table, rows, true))
+            return false;
+
+        {
+            MySqlConnectionByShard conn(group.first.second, pool_, kPoolPriority_Low);
+            if (!conn || !deleteRows(&*conn, table, gone))
+                return false;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        progress_.rows_fixed += rows.size();
+        progress_.rows_orphaned += gone.size();
+    }
+
+    return true;
+}
+
+bool MySqlResharding::readChunk(MySqlConnection *conn, const Table &table, Cursor &cursor,
+                                Rows &rows, const std::string &select) {
+    try {
+        mysqlpp::Query query = conn->query();
+        query << "SELECT ";
+        if (select.empty()) {
+            for (size_t i = 0; i < table.fields.size(); ++i)
+                query << (i ? ",`" : "`") << table.fields[i] << "`";
+        } else {
+            query << select;
+        }
+
+        query << " FROM `" << table.name << "`";
+        if (cursor.started)
+            query << " WHERE `" << table.pkey << "`>" << mysqlpp::quote << cursor.last;
+        query << " ORDER BY `" << table.pkey << "` LIMIT " << chunk_size_;
+
+        mysqlpp::StoreQueryResult res = query.store();
+        if (!res)
+            return false;
+
+        for (size_t i = 0; i < res.num_rows(); ++i)
+            rows.push_back(res[i]);
+
+        if (rows.size() > 0) {
+            // custom select starts with the primary key
+            size_t pkey = select.empty() ? table.pkey_index : 0;
+            cursor.last.assign(rows.back()[pkey].data(), rows.back()[pkey].length());
+            cursor.started = true;
+        }
+
+        cursor.done = rows.size() < chunk_size_;
+        return true;
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("resharding", "read %s@%d: %s", table.name.c_str(), conn->shard(), err.what());
+        return false;
+    }
+}
+
+bool MySqlResharding::readRowsByKeys(MySqlConnection *conn, const Table &table,
+                                     const std::vector<std::string> &keys, Rows &rows,
+                                     const std::string &select) {
+    return readRowsByColumn(conn, table, table.pkey, keys, rows, select);
+}
+
+bool MySqlResharding::readRowsByColumn(MySqlConnection *conn, const Table &table, const std::string &column,
+                                       const std::vector<std::string> &keys, Rows &rows,
+                                       const std::string &select) {
+    if (keys.empty())
+        return true;
+
+    try {
+        mysqlpp::Query query = conn->query();
+        query << "SELECT ";
+        if (select.empty()) {
+            for (size_t i = 0; i < table.fields.size(); ++i)
+                query << (i ? ",`" : "`") << table.fields[i] << "`";
+        } else {
+            query << select;
+        }
+
+        query << " FROM `" << table.name << "` WHERE `" << column << "` IN (";
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (i) query << ",";
+            query << mysqlpp::quote << keys[i];
+        }
+        query << ")";
+
+        mysqlpp::StoreQueryResult res = query.store();
+        if (!res)
+            return false;
+
+        for (size_t i = 0; i < res.num_rows(); ++i)
+            rows.push_back(res[i]);
+        return true;
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("resharding", "read %s@%d: %s", table.name.c_str(), conn->shard(), err.what());
+        return false;
+    }
+}
+
+bool MySqlResharding::writeRows(int shard, const Table &table, const Rows &rows, bool replace) {
+    if (rows.empty())
+        return true;
+
+    MySqlConnectionByShard conn(shard, pool_, kPoolPriority_Low);
+    if (!conn)
+        return false;
+
+    try {
+        mysqlpp::Query query = conn->query();
+        query << (replace ? "REPLACE INTO `" : "INSERT IGNORE INTO `") << table.name << "`(";
+        for (size_t i = 0; i < table.fields.size(); ++i)
+            query << (i ? ",`" : "`") << table.fields[i] << "`";
+        query << ") VALUES ";
+
+        for (size_t r = 0; r < rows.size(); ++r) {
+            query << (r ? ",(" : "(");
+            for (size_t i = 0; i < table.fields.size(); ++i) {
+                if (i) query << ",";
+                if (rows[r][i].is_null())
+                    query << "NULL";
+                else
+                    query << mysqlpp::quote << std::string(rows[r][i].data(), rows[r][i].length());
+            }
+            query << ")";
+        }
+
+        if (query.execute())
+            return true;
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("resharding", "write %s@%d: %s", table.name.c_str(), shard, err.what());
+        return false;
+    }
+
+    return false;
+}
+
+bool MySqlResharding::deleteRows(MySqlConnection *conn, const Table &table, const std::vector<std::string> &keys) {
+    if (keys.empty())
+        return true;
+
+    try {
+        mysqlpp::Query query = conn->query();
+        query << "DELETE FROM `" << table.name << "` WHERE `" << table.pkey << "` IN (";
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (i) query << ",";
+            query << mysqlpp::quote << keys[i];
+        }
+        query << ")";
+
+        if (query.execute())
+            return true;
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("resharding", "delete %s@%d: %s", table.name.c_str(), conn->shard(), err.what());
+    }
+
+    return false;
+}
+
+//
+// CRC32 of all the columns, NULL and '' are different
+//
+std::string MySqlResharding::checksumColumn(const Table &table) {
+    std::ostringstream os;
+    os << "CRC32(CONCAT_WS(','";
+    for (auto &field : table.fields)
+        os << ",IFNULL(HEX(`" << field << "`),'N')";
+    os << "))";
+    return os.str();
+}
+
+void MySqlResharding::throttle() {
+    if (chunk_interval_)
+        std::this_thread::sleep_for(std::chrono::milliseconds(chunk_interval_));
+}
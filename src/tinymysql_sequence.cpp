@@ -0,0 +1,104 @@
+#include "tinymysql_sequence.h"
+#include "tinylogger.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+MySqlSequence::MySqlSequence(const std::string &name, uint32_t block, MySqlShardingPool *pool)
+        : name_(name), block_(block ? block : 1), pool_(pool) {
+    round_ = 0;
+}
+
+bool MySqlSequence::createTable() {
+    if (!pool_) return false;
+
+    bool ok = true;
+    for (int shard = 0; shard < pool_->shardNum(); ++shard) {
+        MySqlConnectionByShard conn(shard, pool_);
+        if (!conn) {
+            ok = false;
+            continue;
+        }
+
+        try {
+            mysqlpp::Query query = conn->query();
+            query << "CREATE TABLE IF NOT EXISTS `" << tableName() << "` ("
+                  << "`NAME` VARCHAR(64) NOT NULL,"
+                  << "`NEXT` BIGINT UNSIGNED NOT NULL,"
+                  << "PRIMARY KEY(`NAME`))";
+            if (!query.execute())
+                ok = false;
+        }
+        catch (std::exception &err) {
+            LOG_ERROR("mysql", "create %s@%d: %s", tableName(), shard, err.what());
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+MySqlSequence::Block *MySqlSequence::block(int shard) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::unique_ptr<Block> &block = blocks_[shard];
+    if (!block)
+        block.reset(new Block);
+    return block.get();
+}
+
+uint64_t MySqlSequence::next(int shard) {
+    if (shard < 0 || shard >= ShardID::kMaxShards)
+        return 0;
+
+    Block *blk = block(shard);
+
+    std::lock_guard<std::mutex> guard(blk->mutex);
+    if (blk->next >= blk->end) {
+        if (!reserve(shard, blk->next, blk->end))
+            return 0;
+    }
+
+    return ShardID::make(blk->next++, shard);
+}
+
+uint64_t MySqlSequence::next() {
+    int shardnum = pool_ ? pool_->shardNum() : 0;
+    if (shardnum <= 0)
+        return 0;
+
+    return next((int) (round_++ % shardnum));
+}
+
+//
+// NEXT is the end of the last reserved block, LAST_INSERT_ID(expr) hands
+// the new value back through the insert id, so a block costs one statement
+//
+bool MySqlSequence::reserve(int shard, uint64_t &start, uint64_t &end) {
+    if (!pool_) return false;
+
+    MySqlConnectionByShard conn(shard, pool_, kPoolPriority_High);
+    if (!conn) {
+        LOG_ERROR("mysql", "sequence %s@%d: shard is not available", name_.c_str(), shard);
+        return false;
+    }
+
+    try {
+        mysqlpp::Query query = conn->query();
+        query << "INSERT INTO `" << tableName() << "`(`NAME`,`NEXT`) VALUES ("
+              << mysqlpp::quote << name_ << ",LAST_INSERT_ID(" << (uint64_t) block_ + 1 << "))"
+              << " ON DUPLICATE KEY UPDATE `NEXT`=LAST_INSERT_ID(`NEXT`+" << block_ << ")";
+
+        mysqlpp::SimpleResult res = query.execute();
+        if (res && res.insert_id() > block_) {
+            end = res.insert_id();
+            start = end - block_;
+            return true;
+        }
+    }
+    catch (std::exception &err) {
+        LOG_ERROR("mysql", "sequence %s@%d: %s", name_.c_str(), shard, err.what());
+        return false;
+    }
+
+    LOG_ERROR("mysql", "sequence %s@%d: reserve FAILED", name_.c_str(), shard);
+    return false;
+}
@@ -187,6 +187,20 @@ TableDescriptorBase &TableDescriptorBase::indexs(const std::initializer_list<std
     return *this;
 }
 
+TableDescriptorBase &TableDescriptorBase::shardKey(const std::string &name, bool embedded) {
+    auto fd = getFieldDescriptor(name);
+    if (fd) {
+        shardkey_ = fd;
+        shardkey_embedded_ = embedded;
+    }
+    return *this;
+}
+
+TableDescriptorBase &TableDescriptorBase::timeout(unsigned int ms) {
+    timeout_ = ms;
+    return *this;
+}
+
 FieldDescriptor::Ptr TableDescriptorBase::getFieldDescriptor(const std::string &name) {
     auto it = fields_.find(name);
     if (it != fields_.end())
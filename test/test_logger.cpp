@@ -0,0 +1,308 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+#include "tinylogger.h"
+
+static std::vector<std::string> read_lines(const std::string &filename) {
+    std::vector<std::string> lines;
+    std::ifstream is(filename);
+    std::string line;
+    while (std::getline(is, line))
+        lines.push_back(line);
+    return lines;
+}
+
+// "2017-01-01 00:00:00.000  INFO: [logger] - text"
+static bool parse_line(const std::string &line, std::string &level, std::string &logger, std::string &text) {
+    if (line.size() < 31 || line[4] != '-' || line[10] != ' ' || line[19] != '.' || line[29] != ':')
+        return false;
+
+    level = line.substr(24, 5);
+    level.erase(0, level.find_first_not_of(' '));
+
+    size_t end = line.find("] - ", 31);
+    if (line.compare(30, 2, " [") || end == std::string::npos)
+        return false;
+
+    logger = line.substr(32, end - 32);
+    text = line.substr(end + 4);
+    return true;
+}
+
+TEST_CASE("async rings keep the order of every thread", "[SimpleLogger]") {
+    const char *filename = "test_logger_order.log";
+    remove(filename);
+
+    SimpleLogger &logger = SimpleLogger::instance();
+    REQUIRE(logger.startAsync(filename, 16, SimpleLogger::kOverflow_Block));
+
+    const int threads = 4, records = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([t]() {
+            for (int i = 0; i < records; ++i)
+                LOG_INFO("order", "%d %d", t, i);
+        }));
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    logger.stopAsync();
+    CHECK(logger.dropped() == 0);
+
+    std::vector<int> next(threads, 0);
+    size_t count = 0;
+    for (auto &line : read_lines(filename)) {
+        std::string level, name, text;
+        REQUIRE(parse_line(line, level, name, text));
+        CHECK(level == "INFO");
+        CHECK(name == "order");
+
+        int t = -1, i = -1;
+        std::istringstream(text) >> t >> i;
+        REQUIRE(t >= 0);
+        REQUIRE(t < threads);
+        CHECK(i == next[t]++);
+        count++;
+    }
+    CHECK(count == (size_t) threads * records);
+
+    remove(filename);
+}
+
+TEST_CASE("async drops are counted and reported", "[SimpleLogger]") {
+    const char *filename = "test_logger_drop.log";
+    remove(filename);
+
+    SimpleLogger &logger = SimpleLogger::instance();
+    const int records = 100000;
+
+    // twice: the count starts again with every startAsync()
+    for (int round = 0; round < 2; ++round) {
+        REQUIRE(logger.startAsync(filename, 2, SimpleLogger::kOverflow_Drop));
+        CHECK(logger.dropped() == 0);
+
+        for (int i = 0; i < records; ++i)
+            LOG_INFO("drop", "%d", i);
+
+        logger.stopAsync();
+        uint64_t dropped = logger.dropped();
+        CHECK(dropped > 0);
+
+        // every line formatted alike, the reports add up to dropped()
+        uint64_t written = 0, reported = 0;
+        for (auto &line : read_lines(filename)) {
+            std::string level, name, text;
+            REQUIRE(parse_line(line, level, name, text));
+            if (name == "SimpleLogger") {
+                CHECK(level == "WARN");
+                CHECK(text.find(" records dropped") != std::string::npos);
+                reported += strtoull(text.c_str(), NULL, 10);
+            } else {
+                CHECK(name == "drop");
+                written++;
+            }
+        }
+
+        CHECK(reported == dropped);
+        CHECK(written + dropped == (uint64_t) records);
+
+        remove(filename);
+    }
+}
+
+//
+// binary mode: the arguments encoded by log_binary() and rendered by format()
+//
+struct BinaryLogger : public SimpleLogger {
+    using SimpleLogger::Encoder;
+
+    template<typename... Args>
+    static std::string render(const char *fmt, const Args &... args) {
+        char buf[LOG_LENGTH_MAX];
+        Encoder encoder(buf, sizeof(buf));
+        encode(encoder, args...);
+        return format(fmt, buf, encoder.p - buf);
+    }
+};
+
+template<typename... Args>
+static std::string printf_string(const char *fmt, const Args &... args) {
+    char buf[LOG_LENGTH_MAX];
+    snprintf(buf, sizeof(buf), fmt, args...);
+    return buf;
+}
+
+#define CHECK_RENDER(fmt, ...) CHECK(BinaryLogger::render(fmt, __VA_ARGS__) == printf_string(fmt, __VA_ARGS__))
+
+TEST_CASE("binary payload renders like printf", "[SimpleLogger]") {
+    CHECK_RENDER("%s", "player");
+    CHECK_RENDER("[%-8s|%8s]", "left", "right");
+    CHECK_RENDER("%d %i %d", 0, -1, -2147483647 - 1);
+    CHECK_RENDER("%ld %lld", (long) -1234567890123L, (long long) 9000000000000000000LL);
+    CHECK_RENDER("%u %lu %llu", 42u, 4000000000UL, 18446744073709551615ULL);
+    CHECK_RENDER("%x %X %o %08x", 255u, 48879u, 8u, 3054u);
+    CHECK_RENDER("%05d|%+d|% d", 42, 42, 42);
+    CHECK_RENDER("%f %.2f %10.3f %e %g", 3.14159, 2.5, -1.0 / 3, 12345.678, 0.0001);
+    CHECK_RENDER("%.1f", 1.5f);
+    CHECK_RENDER("%c%c", 'o', 'k');
+    CHECK_RENDER("%*d|%-*d|%.*f", 6, 7, 4, 8, 2, 9.876);
+    CHECK_RENDER("100%% of %s: %d", "shard", 16);
+    CHECK_RENDER("id=%llu name=%s hp=%.1f lv=%d", 10000000001ULL, "hero", 99.5, -3);
+
+    // missing arguments come out as 0 / ""
+    CHECK(BinaryLogger::render("%s|%d", "only") == "only|0");
+}
+
+struct BinaryLine {
+    int64_t time;
+    int level;
+    std::string logger;
+    std::string text;
+};
+
+// the records of a binary log rendered by format(), as tinylog_decode does
+static bool decode_binary(const std::string &filename, std::vector<BinaryLine> &lines) {
+    std::ifstream in(filename, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const char *p = data.data(), *end = p + data.size();
+
+    auto varint = [&](uint64_t &v) {
+        v = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7) {
+            uint8_t b = (uint8_t) *p++;
+            v |= (uint64_t) (b & 0x7f) << shift;
+            if (!(b & 0x80))
+                return true;
+        }
+        return false;
+    };
+
+    auto string = [&](std::string &s) {
+        uint64_t size = 0;
+        if (!varint(size) || (uint64_t) (end - p) < size)
+            return false;
+        s.assign(p, (size_t) size);
+        p += size;
+        return true;
+    };
+
+    auto time = [&](int64_t &last) {
+        uint64_t v = 0;
+        if (!varint(v)) return false;
+        last += (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+        return true;
+    };
+
+    std::map<uint64_t, std::pair<int, std::pair<std::string, std::string> > > sites;
+    int64_t last = 0;
+    while (p < end) {
+        char tag = *p++;
+        BinaryLine line;
+        uint64_t id = 0, number = 0;
+        std::string file, fmt, payload;
+
+        switch (tag) {
+            case 'H':
+                if (end - p < 5 || std::string(p, 4) != "TLOG" || p[4] != 1)
+                    return false;
+                p += 5;
+                sites.clear();
+                last = 0;
+                break;
+
+            case 'D':
+                if (!varint(id) || p >= end)
+                    return false;
+                line.level = *p++;
+                if (!string(line.logger) || !string(file) || !varint(number) || !string(fmt))
+                    return false;
+                sites[id] = std::make_pair(line.level, std::make_pair(line.logger, fmt));
+                break;
+
+            case 'R':
+                if (!varint(id) || !time(last) || !string(payload) || !sites.count(id))
+                    return false;
+                line.time = last;
+                line.level = sites[id].first;
+                line.logger = sites[id].second.first;
+                line.text = SimpleLogger::format(sites[id].second.second.c_str(), payload.data(), payload.size());
+                lines.push_back(line);
+                break;
+
+            case 'T':
+                if (p >= end)
+                    return false;
+                line.level = *p++;
+                if (!time(last) || !string(line.logger) || !string(line.text))
+                    return false;
+                line.time = last;
+                lines.push_back(line);
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+static void log_sample(int i) {
+    const char *names[] = {"hero", "", "a name with spaces"};
+    LOG_INFO("binary", "player %s id=%llu hp=%.2f level=%d", names[i % 3], 10000000000ULL + i, i * 0.25, -i);
+    LOG_WARN("binary", "%-6s|%6d|%x|%e", "pad", i, (unsigned int) i * 4099, i / 7.0);
+    LOGGER_ERROR("binary", "streamed " << i);
+}
+
+TEST_CASE("binary log decodes to the text log", "[SimpleLogger]") {
+    const char *text_file = "test_logger_text.log";
+    const char *binary_file = "test_logger_binary.log";
+    remove(text_file);
+    remove(binary_file);
+
+    const int records = 100;
+    SimpleLogger &logger = SimpleLogger::instance();
+
+    REQUIRE(logger.startAsync(text_file, 1024, SimpleLogger::kOverflow_Block));
+    for (int i = 0; i < records; ++i)
+        log_sample(i);
+    logger.stopAsync();
+
+    REQUIRE(logger.startAsync(binary_file, 1024, SimpleLogger::kOverflow_Block, SimpleLogger::kFormat_Binary));
+    CHECK(logger.isBinary());
+    for (int i = 0; i < records; ++i)
+        log_sample(i);
+    logger.stopAsync();
+
+    std::vector<std::string> text = read_lines(text_file);
+    std::vector<BinaryLine> binary;
+    REQUIRE(decode_binary(binary_file, binary));
+    REQUIRE(text.size() == 3 * records);
+    REQUIRE(binary.size() == text.size());
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        std::string level, name, message;
+        REQUIRE(parse_line(text[i], level, name, message));
+        CHECK(level == logger.level_name(binary[i].level));
+        CHECK(name == binary[i].logger);
+        CHECK(message == binary[i].text);
+    }
+
+    CHECK(binary[0].text == "player hero id=10000000000 hp=0.00 level=0");
+    CHECK(binary[3].text == "player  id=10000000001 hp=0.25 level=-1");
+    CHECK(binary[5].text == "streamed 1");
+
+    remove(text_file);
+    remove(binary_file);
+}
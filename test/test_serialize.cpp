@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <iostream>
 
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "tinyreflection.h"
 #include "tinyserializer.h"
 #include "tinyserializer_proto.h"
@@ -186,6 +188,46 @@ TEST_CASE("serialize STL containers", "[ProtoSerializer]") {
     }
 }
 
+TEST_CASE("deserialize into live containers", "[ProtoSerializer]") {
+
+    SECTION("appends and reuses the capacity") {
+        std::vector<uint32_t> v1 = {1, 2, 3};
+        std::string data = serialize(v1);
+
+        std::vector<uint32_t> v2 = {9};
+        REQUIRE(deserialize(v2, data));
+        CHECK(v2 == (std::vector<uint32_t>{9, 1, 2, 3}));
+
+        v2.reserve(64);
+        const uint32_t *storage = v2.data();
+        v2.clear();
+        REQUIRE(deserialize(v2, data));
+        CHECK(v2 == v1);
+        CHECK(v2.data() == storage);
+    }
+
+    SECTION("proxy references") {
+        std::vector<bool> v1 = {true, false, true};
+        std::vector<bool> v2;
+        REQUIRE(deserialize(v2, serialize(v1)));
+        CHECK(v1 == v2);
+    }
+
+    SECTION("multimap keeps the order of equal keys") {
+        std::multimap<uint32_t, std::string> m1 = {{1, "a"}, {1, "b"}, {2, "c"}, {1, "d"}};
+        std::multimap<uint32_t, std::string> m2;
+        REQUIRE(deserialize(m2, serialize(m1)));
+        CHECK(m1 == m2);
+    }
+
+    SECTION("existing keys of a map are kept") {
+        std::map<uint32_t, std::string> m1 = {{1, "a"}, {2, "b"}};
+        std::map<uint32_t, std::string> m2 = {{2, "x"}};
+        REQUIRE(deserialize(m2, serialize(m1)));
+        CHECK(m2 == (std::map<uint32_t, std::string>{{1, "a"}, {2, "x"}}));
+    }
+}
+
 struct Weapon {
     uint32_t type = 0;
     std::string name = "";
@@ -227,6 +269,369 @@ TEST_CASE("serialize user defined struct", "[ProtoSerializer]") {
 }
 
 
+//
+// Weapon writing in place
+//
+struct SizedWeapon : public Weapon {
+    size_t byteSize() const {
+        using google::protobuf::io::CodedOutputStream;
+        return 1 + CodedOutputStream::VarintSize32(type) + 1 + CodedOutputStream::VarintSize32(name.size()) + name.size();
+    }
+
+    void serializeTo(google::protobuf::io::CodedOutputStream *os) const {
+        os->WriteTag(1 << 3);
+        os->WriteVarint32(type);
+        os->WriteTag((2 << 3) | 2);
+        os->WriteVarint32(name.size());
+        os->WriteString(name);
+    }
+};
+
+// the format written by nested serialize() calls
+std::string nested_serialize(const std::map<uint32_t, std::vector<Weapon>> &objects) {
+    AssociateProto proto;
+    for (auto &v : objects) {
+        SequenceProto weapons;
+        for (auto &w : v.second)
+            weapons.add_values()->set_data(w.serialize());
+
+        AssociateProto::ValueType *mem = proto.add_values();
+        mem->mutable_key()->set_data(serialize(v.first));
+        mem->mutable_value()->set_data(weapons.SerializeAsString());
+    }
+    return proto.SerializeAsString();
+}
+
+TEST_CASE("serializeTo", "[ProtoSerializer]") {
+
+    std::map<uint32_t, std::vector<Weapon>> weapons;
+    std::map<uint32_t, std::vector<SizedWeapon>> sized_weapons;
+    for (uint32_t i = 0; i < 50; ++i) {
+        for (uint32_t j = 0; j < i; ++j) {
+            Weapon w;
+            w.type = i * 1000 + j;
+            w.name = std::string(j * 3, 'x');
+            weapons[i].push_back(w);
+            sized_weapons[i].push_back(SizedWeapon());
+            static_cast<Weapon &>(sized_weapons[i].back()) = w;
+        }
+    }
+    const std::string expected = nested_serialize(weapons);
+
+    SECTION("wire compatible") {
+        CHECK(serialize(weapons) == expected);
+        CHECK(serialize(sized_weapons) == expected);
+        CHECK((ProtoSized<ProtoSerializer<std::map<uint32_t, std::vector<SizedWeapon>>>,
+                std::map<uint32_t, std::vector<SizedWeapon>>>::value));
+
+        std::vector<std::vector<uint32_t>> nested = {{1, 2}, {}, {3}};
+        SequenceProto proto;
+        for (auto &v : nested)
+            proto.add_values()->set_data(serialize(v));
+        CHECK(serialize(nested) == proto.SerializeAsString());
+    }
+
+    SECTION("appends to a string") {
+        std::string out = "head";
+        serializeTo(sized_weapons, out);
+        CHECK(out == "head" + expected);
+
+        serializeTo(weapons, out);
+        CHECK(out == "head" + expected + expected);
+
+        std::map<uint32_t, std::vector<SizedWeapon>> decoded;
+        REQUIRE(deserialize(decoded, out.substr(4, expected.size())));
+        REQUIRE(decoded.size() == sized_weapons.size());
+        CHECK(decoded[49].back().name == sized_weapons[49].back().name);
+    }
+
+    SECTION("writes to a stream") {
+        std::string out;
+        {
+            google::protobuf::io::StringOutputStream stream(&out);
+            CHECK(serializeTo(weapons, &stream));
+        }
+        CHECK(out == expected);
+    }
+}
+
+//
+// Weapon reading from a view of the buffer
+//
+struct ViewWeapon : public Weapon {
+    static int copies;
+
+    bool deserialize(const std::string &data) {
+        copies++;
+        return Weapon::deserialize(data);
+    }
+
+    bool deserialize(const char *data, size_t size) {
+        WeaponProto proto;
+        if (proto.ParseFromArray(data, (int) size)) {
+            type = proto.type();
+            name = proto.name();
+            return true;
+        }
+        return false;
+    }
+};
+
+int ViewWeapon::copies = 0;
+
+TEST_CASE("deserialize from a buffer", "[ProtoSerializer]") {
+
+    std::map<std::string, std::vector<ViewWeapon>> weapons;
+    for (uint32_t i = 0; i < 10; ++i) {
+        ViewWeapon w;
+        w.type = i;
+        w.name = "weapon-" + std::to_string(i);
+        weapons["player-" + std::to_string(i % 3)].push_back(w);
+    }
+
+    // a row of a result set: no string around the blob, nothing after it is terminated
+    std::string data = serialize(weapons);
+    std::string row = "id" + data + "tail";
+
+    SECTION("nested members are views") {
+        std::map<std::string, std::vector<ViewWeapon>> decoded;
+        REQUIRE(deserialize(decoded, row.data() + 2, data.size()));
+        CHECK(ViewWeapon::copies == 0);
+
+        REQUIRE(decoded.size() == 3);
+        CHECK(decoded["player-1"].size() == 3);
+        CHECK(decoded["player-1"].back().name == "weapon-7");
+        CHECK(decoded["player-1"].back().type == 7);
+    }
+
+    SECTION("same result as from a string") {
+        std::map<std::string, std::vector<ViewWeapon>> from_view, from_string;
+        REQUIRE(deserialize(from_view, row.data() + 2, data.size()));
+        REQUIRE(deserialize(from_string, data));
+        CHECK(serialize(from_view) == serialize(from_string));
+
+        int32_t number = 0;
+        std::string blob = serialize(int32_t(-5));
+        REQUIRE(deserialize(number, blob.data(), blob.size()));
+        CHECK(number == -5);
+    }
+
+    SECTION("malformed") {
+        std::vector<uint32_t> numbers;
+        std::string blob = serialize(std::vector<uint32_t>{1, 2, 3});
+        CHECK_FALSE(deserialize(numbers, blob.data(), blob.size() - 1));
+        CHECK(numbers.empty());
+
+        std::map<std::string, std::vector<ViewWeapon>> decoded;
+        CHECK_FALSE(deserialize(decoded, row.data() + 2, data.size() + 2));
+    }
+
+    SECTION("unknown fields are skipped") {
+        SequenceProto proto;
+        proto.add_values()->set_data(serialize(uint32_t(7)));
+        std::string blob = proto.SerializeAsString();
+        blob += std::string("\x10\x05", 2);  // varint field 2
+        proto.Clear();
+        proto.add_values()->set_data(serialize(uint32_t(8)));
+        blob += proto.SerializePartialAsString();
+
+        std::vector<uint32_t> numbers;
+        REQUIRE(deserialize(numbers, blob.data(), blob.size()));
+        CHECK(numbers == (std::vector<uint32_t>{7, 8}));
+    }
+}
+
+TEST_CASE("packed scalar containers", "[ProtoSerializer]") {
+
+    SECTION("protobuf's packed encoding") {
+        std::vector<int8_t> bytes = {-1, 0, 1, 127};
+        SequenceProto proto;
+        for (auto v : bytes)
+            proto.add_integers(v);
+        CHECK(serialize(bytes) == proto.SerializeAsString());
+
+        std::set<double> floats = {-1.5, 0, 3.25};
+        proto.Clear();
+        for (auto v : floats)
+            proto.add_floats(v);
+        CHECK(serialize(floats) == proto.SerializeAsString());
+
+        CHECK(serialize(std::vector<uint32_t>()).empty());
+    }
+
+    SECTION("smaller") {
+        std::vector<uint32_t> v1(10000);
+        for (size_t i = 0; i < v1.size(); ++i)
+            v1[i] = i * 7;
+
+        SequenceProto members;
+        for (auto v : v1)
+            members.add_values()->set_data(serialize(v));
+
+        std::string data = serialize(v1);
+        CHECK(data.size() * 2 < members.ByteSizeLong());
+
+        std::vector<uint32_t> v2;
+        REQUIRE(deserialize(v2, data));
+        CHECK(v1 == v2);
+    }
+
+    SECTION("round trip") {
+        std::vector<std::string> strings = {"", "david", std::string(300, 'x'), "++"};
+        std::list<std::string> strings2;
+        REQUIRE(deserialize(strings2, serialize(strings)));
+        CHECK(std::equal(strings.begin(), strings.end(), strings2.begin()));
+
+        std::unordered_set<std::string> names = {"a", "b", "c"};
+        std::unordered_set<std::string> names2;
+        REQUIRE(deserialize(names2, serialize(names)));
+        CHECK(names == names2);
+
+        std::deque<float> floats = {1.5f, -2.25f};
+        std::vector<double> floats2;
+        REQUIRE(deserialize(floats2, serialize(floats)));
+        CHECK(floats2 == (std::vector<double>{1.5, -2.25}));
+
+        std::vector<int64_t> negatives = {-1, INT64_MIN, INT64_MAX};
+        std::vector<int64_t> negatives2;
+        REQUIRE(deserialize(negatives2, serialize(negatives)));
+        CHECK(negatives == negatives2);
+    }
+
+    SECTION("members written before still load") {
+        SequenceProto proto;
+        for (uint32_t v : {5, 6, 7})
+            proto.add_values()->set_data(serialize(v));
+
+        std::vector<uint32_t> numbers;
+        REQUIRE(deserialize(numbers, proto.SerializeAsString()));
+        CHECK(numbers == (std::vector<uint32_t>{5, 6, 7}));
+
+        proto.Clear();
+        proto.add_values()->set_data(serialize(std::string("old")));
+        std::string data = proto.SerializeAsString() + serialize(std::vector<std::string>{"new"});
+
+        std::vector<std::string> strings;
+        REQUIRE(deserialize(strings, data));
+        CHECK(strings == (std::vector<std::string>{"old", "new"}));
+    }
+
+    SECTION("malformed") {
+        std::string data = serialize(std::vector<std::string>{"david", "++"});
+        std::vector<std::string> strings;
+        CHECK_FALSE(deserialize(strings, data.data(), data.size() - 1));
+    }
+}
+
+struct GridCell {
+    int32_t x;
+    int32_t y;
+    uint8_t terrain;
+    uint8_t height;
+    uint16_t flags;
+
+    bool operator==(const GridCell &other) const {
+        return x == other.x && y == other.y && terrain == other.terrain
+               && height == other.height && flags == other.flags;
+    }
+};
+
+PROTO_CASE_TRIVIAL(GridCell, kProtoTrivial_User, 4 + 4 + 1 + 1 + 2);
+
+struct GridCell2 {
+    int32_t x;
+    int32_t y;
+};
+
+PROTO_CASE_TRIVIAL(GridCell2, kProtoTrivial_User + 1, 4 + 4);
+
+TEST_CASE("trivially copyable types", "[ProtoSerializer]") {
+
+    std::vector<GridCell> cells;
+    for (int i = 0; i < 1000; ++i)
+        cells.push_back(GridCell{i, -i, (uint8_t) (i % 7), (uint8_t) (i % 5), (uint16_t) i});
+
+    SECTION("one blob") {
+        std::string data = serialize(cells);
+        CHECK(data.size() < cells.size() * sizeof(GridCell) + 32);
+
+        SequenceProto proto;
+        REQUIRE(proto.ParseFromString(data));
+        CHECK(proto.values_size() == 0);
+        CHECK(proto.trivial().size() == sizeof(GridCell));
+        CHECK(proto.trivial().count() == cells.size());
+
+        std::vector<GridCell> cells2;
+        REQUIRE(deserialize(cells2, data));
+        CHECK(cells == cells2);
+
+        std::list<GridCell> cells3;
+        REQUIRE(deserialize(cells3, data));
+        CHECK(std::equal(cells.begin(), cells.end(), cells3.begin()));
+
+        GridCell cell = {};
+        REQUIRE(deserialize(cell, serialize(cells[5])));
+        CHECK(cell == cells[5]);
+    }
+
+    SECTION("std::array") {
+        std::array<GridCell, 3> grid = {{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+        std::array<GridCell, 3> grid2 = {};
+        REQUIRE(deserialize(grid2, serialize(grid)));
+        CHECK(grid == grid2);
+
+        std::array<double, 4> numbers = {{1.5, -2, 0, 1e100}};
+        std::array<double, 4> numbers2 = {};
+        REQUIRE(deserialize(numbers2, serialize(numbers)));
+        CHECK(numbers == numbers2);
+
+        std::array<std::string, 2> names = {{"david", "++"}};
+        std::array<std::string, 2> names2;
+        REQUIRE(deserialize(names2, serialize(names)));
+        CHECK(names == names2);
+
+        // fewer values: the rest is untouched, more: rejected
+        std::array<double, 6> more = {{0, 0, 0, 0, 0, 7}};
+        REQUIRE(deserialize(more, serialize(numbers)));
+        CHECK(more[3] == 1e100);
+        CHECK(more[5] == 7);
+
+        std::array<double, 2> fewer;
+        CHECK_FALSE(deserialize(fewer, serialize(numbers)));
+
+        // from a vector
+        std::array<uint32_t, 3> ints = {};
+        REQUIRE(deserialize(ints, serialize(std::vector<uint32_t>{1, 2, 3})));
+        CHECK(ints[2] == 3);
+    }
+
+    SECTION("another layout is rejected") {
+        std::vector<GridCell2> others;
+        CHECK_FALSE(deserialize(others, serialize(cells)));
+
+        std::array<int64_t, 2> wider;
+        CHECK_FALSE(deserialize(wider, serialize(std::array<int32_t, 2>{{1, 2}})));
+    }
+
+    SECTION("bools are 0 or 1") {
+        std::array<bool, 3> flags = {{true, false, true}};
+        std::array<bool, 3> flags2 = {};
+        std::string data = serialize(flags);
+        REQUIRE(deserialize(flags2, data));
+        CHECK(flags == flags2);
+
+        // the data is the blob's tail
+        data[data.size() - 1] = 2;
+        CHECK_FALSE(deserialize(flags2, data));
+    }
+
+    SECTION("ProtoDynSerializer") {
+        std::vector<GridCell> cells2;
+        REQUIRE(deserialize<ProtoDynSerializer>(cells2, serialize<ProtoDynSerializer>(cells)));
+        CHECK(cells == cells2);
+    }
+}
+
 TEST_CASE("serialize<ProtoDynSerializer> defined struct", "[ProtoDynSerializer]") {
 
     ProtoMappingFactory::instance().declare<Weapon>("Weapon")
@@ -237,6 +642,12 @@ TEST_CASE("serialize<ProtoDynSerializer> defined struct", "[ProtoDynSerializer]"
 
     std::cout << ProtoMappingFactory::instance().protoDefineByType<Weapon>() << std::endl;
 
+    ProtoMapping<Weapon> *mapping = ProtoMappingFactory::instance().mappingByType<Weapon>();
+    REQUIRE(mapping->prototype());
+    CHECK(mapping->descriptor()->name() == "WeaponDynProto");
+    REQUIRE(mapping->fields().size() == 2);
+    CHECK(mapping->fields()[1].descriptor->number() == 2);
+
     Weapon w;
     w.type = 22;
     w.name = "Blade";
@@ -249,3 +660,150 @@ TEST_CASE("serialize<ProtoDynSerializer> defined struct", "[ProtoDynSerializer]"
     CHECK(w.type == w2.type);
     CHECK(w.name == w2.name);
 }
+
+TEST_CASE("ProtoDynSerializer on an arena", "[ProtoDynSerializer]") {
+
+    std::vector<Weapon> weapons(100);
+    for (size_t i = 0; i < weapons.size(); ++i) {
+        weapons[i].type = (int) i;
+        weapons[i].name = "weapon-" + std::to_string(i);
+    }
+
+    // without a scope: the thread's arena, reset after the call
+    std::string data = serialize<ProtoDynSerializer>(weapons);
+    CHECK(ProtoArena::current() == nullptr);
+    CHECK(ProtoArena::local().allocated() <= 64 * 1024);
+
+    ProtoArena arena(1024);
+    {
+        ProtoArena::Scope scope(arena);
+        CHECK(ProtoArena::current() == &arena);
+        CHECK(serialize<ProtoDynSerializer>(weapons) == data);
+
+        std::vector<Weapon> weapons2;
+        REQUIRE(deserialize<ProtoDynSerializer>(weapons2, data));
+        REQUIRE(weapons2.size() == weapons.size());
+        CHECK(weapons2[99].name == "weapon-99");
+
+        const google::protobuf::Message *prototype =
+                ProtoMappingFactory::instance().mappingByType<Weapon>()->prototype();
+        for (int i = 0; i < 100; ++i) {
+            ProtoTempMessage message(prototype);
+            REQUIRE(message->ParseFromString(serialize<ProtoDynSerializer>(weapons2[i])));
+        }
+        CHECK(arena.allocated() > 1024);
+
+        arena.reset();
+        CHECK(arena.allocated() <= 1024);
+
+        // a batch inside a scope keeps the caller's arena
+        ProtoArena::Batch batch;
+        CHECK(ProtoArena::current() == &arena);
+    }
+    CHECK(ProtoArena::current() == nullptr);
+
+    {
+        ProtoArena::Batch batch;
+        CHECK(ProtoArena::current() == &ProtoArena::local());
+        std::vector<Weapon> weapons2;
+        REQUIRE(deserialize<ProtoDynSerializer>(weapons2, data));
+        batch.next();
+        CHECK(weapons2[0].name == "weapon-0");
+    }
+    CHECK(ProtoArena::current() == nullptr);
+
+    // the ORM's loops open a Batch only where temporary messages are made
+    bool batched = std::is_same<ProtoLoadBatch, ProtoArena::Batch>::value;
+    CHECK(batched == (TINYSERIALIZER_DYN_REFLECTION != 0));
+}
+
+struct Armor {
+    int defense = 0;
+    std::string name;
+    std::vector<uint32_t> slots;
+};
+
+TEST_CASE("ProtoDynSerializer on the wire", "[ProtoDynSerializer]") {
+
+    // declared out of number order, one number past 15 (2 byte tag)
+    ProtoMappingFactory::instance().declare<Armor>("Armor")
+            .property<ProtoDynSerializer>("slots", &Armor::slots, 20)
+            .property<ProtoDynSerializer>("defense", &Armor::defense, 1)
+            .property<ProtoDynSerializer>("name", &Armor::name, 3)
+            .done();
+
+    ProtoMapping<Armor> *mapping = ProtoMappingFactory::instance().mappingByType<Armor>();
+    REQUIRE(mapping->prototype());
+    CHECK(mapping->fieldByNumber(20) == 0);
+    CHECK(mapping->fieldByNumber(2) == -1);
+    CHECK(mapping->fieldByNumber(1000) == -1);
+
+    Armor armor;
+    armor.defense = 7;
+    armor.slots = {1, 2, 3};
+
+    // as DynamicMessage
+    std::unique_ptr<google::protobuf::Message> proto(mapping->prototype()->New());
+    const google::protobuf::Reflection *refl = proto->GetReflection();
+    for (auto &field : mapping->fields())
+        refl->SetString(proto.get(), field.descriptor, field.property->serialize(armor));
+
+    std::string data = serialize<ProtoDynSerializer>(armor);
+    CHECK(data == proto->SerializeAsString());
+
+    {
+        Armor armor2;
+        armor2.name = "old";
+        REQUIRE(deserialize<ProtoDynSerializer>(armor2, data));
+        CHECK(armor2.defense == 7);
+        CHECK(armor2.name.empty());
+        CHECK(armor2.slots == armor.slots);
+    }
+
+    // unknown fields skipped, the last occurrence wins
+    {
+        google::protobuf::UnknownFieldSet *unknown = refl->MutableUnknownFields(proto.get());
+        unknown->AddVarint(2, 99);
+        unknown->AddLengthDelimited(100, "ignored");
+        std::string data2 = proto->SerializeAsString() + serialize<ProtoDynSerializer>(Armor());
+
+        Armor armor2;
+        REQUIRE(deserialize<ProtoDynSerializer>(armor2, data2));
+        CHECK(armor2.defense == 0);
+        CHECK(armor2.slots.empty());
+
+        CHECK_THROWS(deserialize<ProtoDynSerializer>(armor2, data.data(), data.size() - 1));
+    }
+}
+
+TEST_CASE("ProtoDynSerializer malformed member in a container", "[ProtoDynSerializer]") {
+
+    Armor armor;
+    armor.defense = 1;
+    armor.name = "Shield";
+
+    // ArchiveMemberProto { data = 1 } of an ArmorDynProto { defense = 1 } cut short
+    std::string bad("\x0a\x03\x0a\x05" "a", 5);
+
+    std::string data = serialize<ProtoDynSerializer>(std::vector<Armor>(1, armor));
+    data += std::string("\x0a\x05", 2) + bad;
+
+    std::vector<Armor> armors;
+    CHECK_THROWS(deserialize<ProtoDynSerializer>(armors, data));
+    REQUIRE(armors.size() == 1);
+    CHECK(armors[0].name == "Shield");
+
+    // AssociateProto::ValueType { key = 1, value = 2 }
+    std::string key = serialize<ProtoDynSerializer>(2);
+    key = std::string("\x0a", 1) + (char) key.size() + key;
+    std::string pair = std::string("\x0a", 1) + (char) key.size() + key + std::string("\x12\x05", 2) + bad;
+
+    std::map<int, Armor> map;
+    map[1] = armor;
+    data = serialize<ProtoDynSerializer>(map) + std::string("\x0a", 1) + (char) pair.size() + pair;
+
+    std::map<int, Armor> map2;
+    CHECK_THROWS(deserialize<ProtoDynSerializer>(map2, data));
+    REQUIRE(map2.size() == 1);
+    CHECK(map2.count(1));
+}
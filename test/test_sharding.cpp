@@ -0,0 +1,1065 @@
+#define CATCH_CONFIG_MAIN  // This tells Catch to provide a main() - only do this in one cpp file
+
+#include "catch.hpp"
+
+#include <string>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+
+#include "sharding.h"
+#include "breaker.h"
+#include "latency.h"
+#include "shardstats.h"
+#include "pool.h"
+#include "workers.h"
+#include "gather.h"
+#include "shardbatch.h"
+
+struct DummyShard {
+    DummyShard(int id = -1) : id_(id) {}
+
+    int shard() const { return id_; }
+
+    int id_;
+};
+
+//
+// fraction of keys routed to another shard when shardnum grows from N to N+1
+//
+double moved_ratio(ShardingStrategy strategy, int shardnum, int keys = 100000) {
+    Sharding<DummyShard> before(shardnum);
+    before.setStrategy(strategy);
+
+    Sharding<DummyShard> after(shardnum + 1);
+    after.setStrategy(strategy);
+
+    int moved = 0;
+    for (int i = 0; i < keys; ++i) {
+        uint32_t hash = MurmurHash::hash("player-" + std::to_string(i));
+        if (before.shardIDByHash(hash) != after.shardIDByHash(hash))
+            moved++;
+    }
+
+    return (double) moved / keys;
+}
+
+TEST_CASE("shard remapping when adding a shard", "[Sharding]") {
+
+    SECTION("range") {
+        CHECK(moved_ratio(kSharding_Range, 8) > 0.5);
+    }
+
+    SECTION("ketama") {
+        CHECK(moved_ratio(kSharding_Ketama, 8) < 0.2);
+    }
+
+    SECTION("jump") {
+        CHECK(moved_ratio(kSharding_Jump, 8) < 0.2);
+    }
+}
+
+TEST_CASE("shard distribution", "[Sharding]") {
+
+    const int shardnum = 8;
+    const int keys = 100000;
+
+    for (ShardingStrategy strategy : {kSharding_Range, kSharding_Ketama, kSharding_Jump}) {
+        Sharding<DummyShard> sharding(shardnum);
+        sharding.setStrategy(strategy);
+
+        std::vector<int> counts(shardnum, 0);
+        for (int i = 0; i < keys; ++i) {
+            int shard = sharding.shardIDByHash(MurmurHash::hash("player-" + std::to_string(i)));
+            REQUIRE(shard >= 0);
+            REQUIRE(shard < shardnum);
+            counts[shard]++;
+        }
+
+        for (int count : counts) {
+            CHECK(count > keys / shardnum * 0.7);
+            CHECK(count < keys / shardnum * 1.3);
+        }
+    }
+}
+
+TEST_CASE("ketama shard weight", "[Sharding]") {
+
+    Sharding<DummyShard> sharding(2);
+    sharding.setStrategy(kSharding_Ketama);
+    sharding.setShardWeight(1, 3);
+
+    int counts[2] = {0, 0};
+    for (int i = 0; i < 100000; ++i)
+        counts[sharding.shardIDByHash(MurmurHash::hash("player-" + std::to_string(i)))]++;
+
+    CHECK(counts[1] > counts[0] * 2);
+
+    DummyShard shard0(0), shard1(1);
+    CHECK(sharding.addShard(&shard0));
+    CHECK(sharding.addShard(&shard1));
+    CHECK_FALSE(sharding.addShard(&shard1));
+    CHECK(sharding.isReady());
+    CHECK(sharding.getShardByKey("david") != NULL);
+}
+
+TEST_CASE("migration window", "[Sharding]") {
+
+    std::vector<DummyShard> shards;
+    for (int i = 0; i < 4; ++i)
+        shards.push_back(DummyShard(i));
+
+    Sharding<DummyShard> sharding(2);
+    sharding.setStrategy(kSharding_Jump);
+    CHECK(sharding.addShard(&shards[0]));
+    CHECK(sharding.addShard(&shards[1]));
+
+    // new shards are not there yet
+    CHECK_FALSE(sharding.beginMigration(4));
+
+    CHECK(sharding.addShard(&shards[2]));
+    CHECK(sharding.addShard(&shards[3]));
+    CHECK(sharding.beginMigration(4));
+    CHECK(sharding.isMigrating());
+    CHECK(sharding.shardNum() == 2);
+
+    int dual = 0;
+    for (int i = 0; i < 1000; ++i) {
+        std::string key = "player-" + std::to_string(i);
+        int ids[2];
+        int n = sharding.writeShardIDsByKey(key, ids);
+        CHECK(ids[0] == sharding.shardIDByKey(key));
+        if (n == 2) {
+            CHECK(ids[1] == sharding.nextShardIDByKey(key));
+            dual++;
+        }
+    }
+    CHECK(dual > 0);
+
+    // the next layout would not follow a reconfiguration
+    CHECK_FALSE(sharding.setShardNum(3));
+    CHECK_FALSE(sharding.setStrategy(kSharding_Ketama));
+    CHECK_FALSE(sharding.setShardWeight(1, 3));
+    CHECK_FALSE(sharding.beginMigration(4));
+
+    CHECK(sharding.commitMigration());
+    CHECK_FALSE(sharding.isMigrating());
+    CHECK(sharding.shardNum() == 4);
+    CHECK(sharding.strategy() == kSharding_Jump);
+    CHECK(sharding.setStrategy(kSharding_Ketama));
+}
+
+TEST_CASE("reconfiguration cap", "[Sharding]") {
+
+    typedef Sharding<DummyShard> DummySharding;
+    DummySharding sharding(2);
+
+    // the constructor published one layout
+    for (int i = 1; i < DummySharding::kMaxLayouts; ++i)
+        CHECK(sharding.setShardNum(i % 2 ? 2 : 4));
+    CHECK_FALSE(sharding.setShardNum(8));
+    CHECK_FALSE(sharding.beginMigration(1));
+    CHECK(sharding.shardNum() == 2);
+
+    std::vector<DummyShard> shards;
+    for (int i = 0; i < 2; ++i)
+        shards.push_back(DummyShard(i));
+    // shards are capped separately
+    CHECK(sharding.addShard(&shards[0]));
+    CHECK(sharding.addShard(&shards[1]));
+    CHECK(sharding.isReady());
+}
+
+TEST_CASE("migration skips stale copies", "[Sharding]") {
+
+    std::vector<DummyShard> shards;
+    for (int i = 0; i < 8; ++i)
+        shards.push_back(DummyShard(i));
+
+    Sharding<DummyShard> sharding(2);
+    sharding.setStrategy(kSharding_Jump);
+    for (auto &shard : shards)
+        CHECK(sharding.addShard(&shard));
+
+    // 2 -> 4, not purged: the moved rows stay on shards 0 and 1
+    CHECK(sharding.beginMigration(4));
+    std::vector<std::pair<std::string, int> > leftovers;
+    for (int i = 0; i < 1000; ++i) {
+        std::string key = "player-" + std::to_string(i);
+        int owner = sharding.shardIDByKey(key);
+        int next = sharding.movingShardIDByKey(key, owner);
+        if (next >= 0) {
+            CHECK(next == sharding.nextShardIDByKey(key));
+            leftovers.push_back(std::make_pair(key, owner));
+        } else {
+            CHECK(sharding.nextShardIDByKey(key) == owner);
+        }
+
+        // only the owner moves a row
+        for (int shard = 0; shard < 4; ++shard) {
+            if (shard != owner)
+                CHECK(sharding.movingShardIDByKey(key, shard) == -1);
+        }
+    }
+    CHECK(leftovers.size() > 0);
+    CHECK(sharding.commitMigration());
+
+    // 4 -> 8: the stale copies are never copied again
+    CHECK(sharding.beginMigration(8));
+    int moving = 0;
+    for (auto &leftover : leftovers) {
+        const std::string &key = leftover.first;
+        CHECK(sharding.shardIDByKey(key) != leftover.second);
+        CHECK(sharding.movingShardIDByKey(key, leftover.second) == -1);
+
+        if (sharding.movingShardIDByKey(key, sharding.shardIDByKey(key)) >= 0)
+            moving++;
+    }
+    CHECK(moving > 0);
+    CHECK(sharding.commitMigration());
+
+    // not migrating: nothing moves
+    CHECK(sharding.movingShardIDByKey("player-1", sharding.shardIDByKey("player-1")) == -1);
+}
+
+TEST_CASE("shard embedded ids", "[ShardID]") {
+
+    SECTION("hi/lo") {
+        uint64_t id = ShardID::make(123456789, 7);
+        CHECK(ShardID::shard(id) == 7);
+        CHECK(ShardID::sequence(id) == 123456789);
+
+        std::vector<DummyShard> shards;
+        for (int i = 0; i < 8; ++i)
+            shards.push_back(DummyShard(i));
+
+        Sharding<DummyShard> sharding(8);
+        for (auto &shard : shards)
+            sharding.addShard(&shard);
+        CHECK(sharding.getShardByEmbeddedID(id) == &shards[7]);
+    }
+
+    SECTION("snowflake") {
+        SnowflakeIDGenerator generator(3);
+
+        std::vector<uint64_t> ids;
+        for (int i = 0; i < 10000; ++i)
+            ids.push_back(generator.next(i % 16));
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            CHECK(ShardID::shard(ids[i]) == (int) (i % 16));
+            CHECK(generator.worker(ids[i]) == 3);
+            if (i) CHECK(ShardID::sequence(ids[i]) > ShardID::sequence(ids[i - 1]));
+        }
+
+        std::sort(ids.begin(), ids.end());
+        CHECK(std::unique(ids.begin(), ids.end()) == ids.end());
+
+        uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        CHECK(generator.timestamp(ids.back()) <= now);
+        CHECK(generator.timestamp(ids.back()) + 10000 > now);
+    }
+}
+
+TEST_CASE("circuit breaker", "[Health]") {
+    CircuitBreaker breaker(3, 50);
+
+    CHECK(breaker.allow());
+    breaker.failure();
+    breaker.failure();
+    CHECK(breaker.state() == CircuitBreaker::kState_Closed);
+
+    // a success resets the run of failures
+    breaker.success();
+    breaker.failure();
+    breaker.failure();
+    CHECK(breaker.allow());
+
+    breaker.failure();
+    CHECK(breaker.state() == CircuitBreaker::kState_Open);
+    CHECK_FALSE(breaker.allow());
+    CHECK_FALSE(breaker.available());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    // one probe at a time
+    CHECK(breaker.available());
+    CHECK(breaker.allow());
+    CHECK(breaker.state() == CircuitBreaker::kState_HalfOpen);
+    CHECK_FALSE(breaker.allow());
+
+    // failed probe opens it again
+    breaker.failure();
+    CHECK(breaker.state() == CircuitBreaker::kState_Open);
+    CHECK(breaker.opens() == 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    CHECK(breaker.allow());
+    breaker.success();
+    CHECK(breaker.state() == CircuitBreaker::kState_Closed);
+    CHECK(breaker.allow());
+}
+
+TEST_CASE("circuit breaker guard", "[Health]") {
+    CircuitBreaker breaker(1, 20);
+
+    CHECK(breaker.allow());
+    {
+        CircuitBreaker::Guard guard(breaker);
+        guard.success();
+    }
+    CHECK(breaker.state() == CircuitBreaker::kState_Closed);
+
+    // an op throwing is a failure
+    try {
+        CHECK(breaker.allow());
+        CircuitBreaker::Guard guard(breaker);
+        throw std::runtime_error("lost connection");
+    }
+    catch (std::exception &) {
+    }
+    CHECK(breaker.state() == CircuitBreaker::kState_Open);
+
+    // and the probe is given back
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    try {
+        CHECK(breaker.allow());
+        CircuitBreaker::Guard guard(breaker);
+        throw std::runtime_error("lost connection");
+    }
+    catch (std::exception &) {
+    }
+    CHECK(breaker.state() == CircuitBreaker::kState_Open);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    CHECK(breaker.allow());
+    breaker.success();
+    CHECK(breaker.state() == CircuitBreaker::kState_Closed);
+}
+
+TEST_CASE("worker pool", "[Health]") {
+    WorkerPool workers(2);
+    CHECK(workers.size() == 2);
+
+    // wait until both are started
+    while (workers.idle() < 2)
+        std::this_thread::yield();
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool release = false;
+    std::atomic<int> done(0);
+
+    auto task = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]() { return release; });
+        done++;
+    };
+
+    CHECK(workers.tryPost(task));
+    CHECK(workers.tryPost(task));
+
+    // all busy: refused, never queued
+    CHECK_FALSE(workers.tryPost(task));
+    CHECK(workers.idle() == 0);
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        release = true;
+    }
+    cond.notify_all();
+
+    while (done < 2 || workers.idle() < 2)
+        std::this_thread::yield();
+
+    CHECK(workers.tryPost(task));
+    while (done < 3 || workers.idle() < 2)
+        std::this_thread::yield();
+
+    // post() queues behind the busy workers, still 2 threads
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        release = false;
+    }
+    for (int i = 0; i < 5; ++i)
+        CHECK(workers.post(task));
+    while (workers.queued() > 3)
+        std::this_thread::yield();
+    CHECK(workers.queued() == 3);
+    CHECK(workers.idle() == 0);
+    CHECK_FALSE(workers.tryPost(task));
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        release = true;
+    }
+    cond.notify_all();
+
+    while (done < 8)
+        std::this_thread::yield();
+    CHECK(workers.queued() == 0);
+}
+
+TEST_CASE("latency percentiles", "[Health]") {
+
+    SECTION("buckets") {
+        for (uint64_t us = 0; us < 100000; us += 7) {
+            size_t b = LatencyTracker::bucket(us);
+            CHECK(us <= LatencyTracker::upper(b));
+            if (b > 0) CHECK(us > LatencyTracker::upper(b - 1));
+        }
+        CHECK(LatencyTracker::bucket(UINT64_MAX) < LatencyTracker::kBuckets);
+    }
+
+    SECTION("percentile") {
+        LatencyTracker tracker;
+        CHECK(tracker.percentile(95) == 0);
+
+        for (uint64_t us = 1; us <= 10000; ++us)
+            tracker.record(us);
+
+        CHECK(tracker.count() == 10000);
+        CHECK(tracker.mean() == 5000);
+
+        uint64_t p50 = tracker.percentile(50);
+        uint64_t p95 = tracker.percentile(95);
+        CHECK(p50 >= 5000);
+        CHECK(p50 <= 5000 * 1.25);
+        CHECK(p95 >= 9500);
+        CHECK(p95 <= 9500 * 1.25);
+    }
+}
+
+TEST_CASE("hot keys", "[Stats]") {
+
+    SECTION("count-min never under-estimates") {
+        CountMinSketch sketch(1024, 4);
+        for (int i = 0; i < 5000; ++i)
+            sketch.add("key-" + std::to_string(i % 500), 1);
+
+        for (int i = 0; i < 500; ++i)
+            CHECK(sketch.estimate("key-" + std::to_string(i)) >= 10);
+        CHECK(sketch.estimate("key-0") < 30);
+    }
+
+    SECTION("top-k of a skewed stream") {
+        HotKeyTracker tracker(5);
+        for (int i = 0; i < 20000; ++i) {
+            tracker.record("cold-" + std::to_string(i), i % 4);
+            if (i % 10 == 0) tracker.record("hot-1", 1);
+            if (i % 20 == 0) tracker.record("hot-2", 2);
+        }
+
+        auto top = tracker.top(2);
+        REQUIRE(top.size() == 2);
+        CHECK(top[0].key == "hot-1");
+        CHECK(top[0].shard == 1);
+        CHECK(top[0].count >= 2000);
+        CHECK(top[1].key == "hot-2");
+    }
+
+    SECTION("per-shard stats") {
+        ShardingStats stats;
+        for (int i = 0; i < 100; ++i) {
+            stats.record(1, 1000, i % 10 != 0);
+            stats.touch(1, "player-1");
+        }
+        stats.record(3, 50);
+
+        auto shards = stats.shards();
+        REQUIRE(shards.size() == 2);
+        CHECK(shards[0].shard == 1);
+        CHECK(shards[0].requests == 100);
+        CHECK(shards[0].errors == 10);
+        CHECK(shards[0].qps > 0);
+        CHECK(shards[0].p99 >= 1000);
+        CHECK(stats.shard(2).requests == 0);
+
+        auto keys = stats.hotKeys(1);
+        REQUIRE(keys.size() == 1);
+        CHECK(keys[0].key == "player-1");
+        CHECK(stats.dump().find("shard 1:") != std::string::npos);
+    }
+}
+
+template<typename Hash>
+void check_distribution(int buckets = 64, int keys = 200000) {
+    std::vector<int> counts(buckets, 0);
+    for (int i = 0; i < keys; ++i)
+        counts[Hash::hash("player-" + std::to_string(i)) / (4294967296ULL / buckets)]++;
+
+    // chi-square with 63 degrees of freedom, p=0.001 is ~104
+    double expected = (double) keys / buckets;
+    double chi2 = 0;
+    for (int count : counts)
+        chi2 += (count - expected) * (count - expected) / expected;
+    CHECK(chi2 < 104);
+}
+
+// average fraction of the output bits flipped by flipping one input bit
+template<typename Hash64>
+double avalanche(Hash64 hash, int keys = 2000) {
+    uint64_t flipped = 0, total = 0;
+    for (int i = 0; i < keys; ++i) {
+        std::string key = "key-" + std::to_string(i * 7919);
+        uint64_t base = hash(key);
+        for (size_t bit = 0; bit < key.size() * 8; ++bit) {
+            std::string changed = key;
+            changed[bit / 8] ^= (char) (1 << (bit % 8));
+            flipped += __builtin_popcountll(base ^ hash(changed));
+            total += 64;
+        }
+    }
+    return (double) flipped / total;
+}
+
+TEST_CASE("hash kernels", "[Hash]") {
+
+    SECTION("reference values") {
+        CHECK(hash_xxh64("", 0) == 0xef46db3751d8e999ULL);
+        CHECK(hash_xxh64("abc", 3) == 0x44bc2cf5ad770999ULL);
+        CHECK(hash_xxh64(std::string("Nobody inspects the spammish repetition")) == 0xfbcea83c8a378bf1ULL);
+
+        uint64_t out[2];
+        std::string fox = "The quick brown fox jumps over the lazy dog";
+        hash_murmur3_128(fox.data(), fox.size(), 0, out);
+        CHECK(out[0] == 0xe34bbc7bbc071b6cULL);
+        CHECK(out[1] == 0x7a433ca9c49a9347ULL);
+
+        CHECK(hash_crc32c("123456789", 9) == 0xe3069283);
+        CHECK(hash_crc32c("6789", 4, hash_crc32c("12345", 5)) == 0xe3069283);
+    }
+
+    SECTION("crc32c hardware and software agree") {
+        std::string data;
+        for (int i = 0; i < 1000; ++i)
+            data += (char) (i * 131 + 7);
+
+        for (size_t offset = 0; offset < 8; ++offset) {
+            for (size_t length = 0; length < 200; length += 13) {
+                CHECK(hash_crc32c(data.data() + offset, length) ==
+                      hash_crc32c_soft(data.data() + offset, length));
+            }
+        }
+    }
+
+    SECTION("distribution") {
+        check_distribution<MurmurHash>();
+        check_distribution<XXHash64>();
+        check_distribution<Murmur3Hash>();
+    }
+
+    SECTION("avalanche") {
+        double xxh = avalanche([](const std::string &key) { return hash_xxh64(key); });
+        double mm3 = avalanche([](const std::string &key) { return hash_murmur3_64(key); });
+        CHECK(xxh > 0.49);
+        CHECK(xxh < 0.51);
+        CHECK(mm3 > 0.49);
+        CHECK(mm3 < 0.51);
+    }
+
+    SECTION("sharding with the hashes") {
+        Sharding<DummyShard, XXHash64> xxh(8);
+        Sharding<DummyShard, CRC32CHash> crc(8);
+        crc.setStrategy(kSharding_Jump);
+
+        std::vector<int> counts[2] = {std::vector<int>(8, 0), std::vector<int>(8, 0)};
+        for (int i = 0; i < 80000; ++i) {
+            std::string key = "player-" + std::to_string(i);
+            counts[0][xxh.shardIDByKey(key)]++;
+            counts[1][crc.shardIDByKey(key)]++;
+        }
+
+        for (auto &shards : counts) {
+            for (int count : shards) {
+                CHECK(count > 10000 * 0.9);
+                CHECK(count < 10000 * 1.1);
+            }
+        }
+    }
+}
+
+TEST_CASE("flat shard table", "[Sharding]") {
+
+    SECTION("range routing by shift and by division") {
+        for (int shardnum : {1, 2, 3, 7, 8, 64, 100, 1024}) {
+            Sharding<DummyShard> sharding(shardnum);
+            for (uint32_t hash : {0u, 1u, 12345678u, 0x80000000u, 0xfffffffeu, 0xffffffffu}) {
+                int shard = sharding.shardIDByHash(hash);
+                CHECK(shard >= 0);
+                CHECK(shard < shardnum);
+                CHECK(shard == std::min<uint64_t>(hash / (4294967296ULL / shardnum), shardnum - 1));
+            }
+        }
+    }
+
+    SECTION("lookup") {
+        Sharding<DummyShard> sharding(4);
+        DummyShard shard2(2), shard9(9), invalid(-1), toolarge(ShardID::kMaxShards);
+
+        CHECK(sharding.getShardByID(0) == NULL);
+        CHECK(sharding.getShardByID(-1) == NULL);
+        CHECK(sharding.addShard(&shard2));
+        CHECK(sharding.addShard(&shard9));
+        CHECK_FALSE(sharding.addShard(&invalid));
+        CHECK_FALSE(sharding.addShard(&toolarge));
+
+        CHECK(sharding.getShardByID(2) == &shard2);
+        CHECK(sharding.getShardByID(9) == &shard9);
+        CHECK(sharding.getShardByID(3) == NULL);
+        CHECK(sharding.getShardByID(10) == NULL);
+        CHECK_FALSE(sharding.isReady());
+    }
+
+    SECTION("adding shards while routing") {
+        Sharding<DummyShard> sharding(64);
+        std::vector<DummyShard> shards;
+        for (int i = 0; i < 64; ++i)
+            shards.push_back(DummyShard(i));
+
+        std::atomic<bool> stop(false);
+        std::atomic<int> wrong(0);
+        std::thread reader([&]() {
+            while (!stop) {
+                for (int i = 0; i < 64; ++i) {
+                    DummyShard *shard = sharding.getShardByID(i);
+                    if (shard && shard->shard() != i)
+                        wrong++;
+                }
+            }
+        });
+
+        for (int i = 63; i >= 0; --i)
+            CHECK(sharding.addShard(&shards[i]));
+
+        stop = true;
+        reader.join();
+
+        CHECK(wrong == 0);
+        CHECK(sharding.isReady());
+    }
+}
+
+struct DummyConnection {
+};
+
+class DummyPool : public ConnectionPoolWithLimit<DummyConnection> {
+public:
+    explicit DummyPool(const PoolAdaptivePolicy &policy) {
+        setAdaptivePolicy(policy);
+        setGrabWaitTime(0);
+    }
+
+    DummyConnection *create() final {
+        created++;
+        return new DummyConnection();
+    }
+
+    void destroy(DummyConnection *conn) final {
+        destroyed++;
+        delete conn;
+    }
+
+    unsigned int waiting(PoolPriority priority) {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return waiting_[priority];
+    }
+
+    int created = 0;
+    int destroyed = 0;
+};
+
+TEST_CASE("adaptive pool size", "[Pool]") {
+    PoolAdaptivePolicy policy;
+    policy.enabled = true;
+    policy.min_conns = 2;
+    policy.max_conns = 4;
+    policy.grow_waittime = 1000000;
+    policy.cooldown = 0;
+    policy.shrink_idletime = 1;
+
+    DummyPool pool(policy);
+    CHECK(pool.stats().target == 2);
+
+    // grows with the utilization, up to max_conns
+    std::vector<DummyConnection *> conns;
+    for (int i = 0; i < 4; ++i) {
+        conns.push_back(pool.acquire());
+        REQUIRE(conns.back());
+    }
+    CHECK(pool.stats().target == 4);
+    CHECK(pool.stats().grows == 2);
+    CHECK(pool.acquire() == NULL);
+    CHECK(pool.stats().target == 4);
+
+    for (auto conn : conns)
+        pool.putback(conn);
+    CHECK(pool.stats().connections == 4);
+    CHECK(pool.stats().shrinks == 0);
+
+    // idle without traffic: a step down per shrink_idletime, only the
+    // connections above the target are destroyed
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    pool.adjust();
+    CHECK(pool.stats().target == 3);
+    CHECK(pool.stats().connections == 3);
+    CHECK(pool.destroyed == 1);
+
+    pool.adjust();
+    CHECK(pool.stats().target == 3);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    pool.adjust();
+    CHECK(pool.stats().target == 2);
+    CHECK(pool.stats().connections == 2);
+
+    // never below min_conns
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    pool.adjust();
+    CHECK(pool.stats().target == 2);
+    CHECK(pool.stats().shrinks == 2);
+
+    // the idle connections are reused
+    DummyConnection *conn = pool.acquire();
+    pool.putback(conn);
+    CHECK(pool.created == 4);
+}
+
+TEST_CASE("adaptive pool cooldown", "[Pool]") {
+    PoolAdaptivePolicy policy;
+    policy.enabled = true;
+    policy.min_conns = 1;
+    policy.max_conns = 4;
+    policy.grow_waittime = 1000000;
+    policy.cooldown = 1;
+
+    DummyPool pool(policy);
+    DummyConnection *a = pool.acquire();
+    REQUIRE(a);
+
+    // busy, but adjusted too recently
+    CHECK(pool.acquire() == NULL);
+    CHECK(pool.stats().target == 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    pool.adjust();
+    CHECK(pool.stats().target == 2);
+
+    DummyConnection *b = pool.acquire();
+    REQUIRE(b);
+    CHECK(pool.acquire() == NULL);
+    CHECK(pool.stats().target == 2);
+
+    pool.putback(a);
+    pool.putback(b);
+}
+
+TEST_CASE("pool reserved connections", "[Pool]") {
+    DummyPool pool((PoolAdaptivePolicy()));
+    pool.setMaxConn(4);
+    pool.setHighReserved(50);
+
+    // Normal and Low share the 2 not reserved
+    DummyConnection *normal = pool.acquire(kPoolPriority_Normal);
+    DummyConnection *low = pool.acquire(kPoolPriority_Low);
+    REQUIRE(normal);
+    REQUIRE(low);
+    CHECK(pool.acquire(kPoolPriority_Normal) == NULL);
+    CHECK(pool.acquire(kPoolPriority_Low) == NULL);
+
+    // High takes the reserved ones, then no more
+    DummyConnection *high1 = pool.acquire(kPoolPriority_High);
+    DummyConnection *high2 = pool.acquire(kPoolPriority_High);
+    REQUIRE(high1);
+    REQUIRE(high2);
+    CHECK(pool.acquire(kPoolPriority_High) == NULL);
+
+    // a reserved one freed is still High's only
+    pool.putback(high1);
+    CHECK(pool.acquire(kPoolPriority_Normal) == NULL);
+    high1 = pool.acquire(kPoolPriority_High);
+    CHECK(high1);
+
+    for (auto conn : {normal, low, high1, high2})
+        pool.putback(conn);
+    CHECK(pool.stats().in_use == 0);
+
+    // never all of them reserved
+    pool.setHighReserved(100);
+    normal = pool.acquire(kPoolPriority_Normal);
+    CHECK(normal);
+    CHECK(pool.acquire(kPoolPriority_Low) == NULL);
+    pool.putback(normal);
+}
+
+TEST_CASE("pool priority lanes", "[Pool]") {
+    DummyPool pool((PoolAdaptivePolicy()));
+    pool.setMaxConn(4);
+    pool.setHighReserved(50);
+    pool.setGrabWaitTime(-1);
+
+    std::vector<DummyConnection *> held;
+    for (int i = 0; i < 4; ++i)
+        held.push_back(pool.acquire(kPoolPriority_High));
+
+    std::mutex mutex;
+    std::vector<PoolPriority> served;
+    std::map<PoolPriority, DummyConnection *> conns;
+    auto wait_served = [&](size_t n) {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (served.size() >= n)
+                    return;
+            }
+            std::this_thread::yield();
+        }
+    };
+    auto served_count = [&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> guard(mutex);
+        return served.size();
+    };
+
+    // queued in the reverse order of their priority
+    std::vector<std::thread> waiters;
+    for (PoolPriority priority : {kPoolPriority_Low, kPoolPriority_Normal, kPoolPriority_High}) {
+        waiters.push_back(std::thread([&, priority]() {
+            DummyConnection *conn = pool.acquire(priority);
+            std::lock_guard<std::mutex> guard(mutex);
+            served.push_back(priority);
+            conns[priority] = conn;
+        }));
+        while (pool.waiting(priority) == 0)
+            std::this_thread::yield();
+    }
+
+    // High first
+    pool.putback(held.back());
+    held.pop_back();
+    wait_served(1);
+
+    // free, but reserved: Normal waits until 2 are in use at most
+    pool.putback(held.back());
+    held.pop_back();
+    pool.putback(held.back());
+    held.pop_back();
+    CHECK(served_count() == 1);
+
+    pool.putback(held.back());
+    held.pop_back();
+    wait_served(2);
+
+    // Low once the reservation and the Normal waiter let it
+    CHECK(served_count() == 2);
+    pool.putback(conns[kPoolPriority_High]);
+    wait_served(3);
+
+    for (auto &waiter : waiters)
+        waiter.join();
+
+    CHECK(served == std::vector<PoolPriority>({kPoolPriority_High, kPoolPriority_Normal, kPoolPriority_Low}));
+    pool.putback(conns[kPoolPriority_Normal]);
+    pool.putback(conns[kPoolPriority_Low]);
+    CHECK(pool.stats().in_use == 0);
+}
+
+TEST_CASE("gather merge sorted", "[Gather]") {
+    typedef std::vector<std::shared_ptr<int>> Records;
+
+    // 8 shards of sorted parts, some empty, with duplicates across them
+    std::vector<Records> parts(8);
+    std::vector<int> all;
+    unsigned int seed = 7;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (i == 3) continue;
+
+        std::vector<int> values;
+        size_t count = i * 13 % 50;
+        for (size_t j = 0; j < count; ++j) {
+            seed = seed * 1103515245 + 12345;
+            values.push_back((int) (seed >> 16) % 100);
+        }
+
+        std::sort(values.begin(), values.end(), std::greater<int>());
+        for (int v : values)
+            parts[i].push_back(std::make_shared<int>(v));
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end(), std::greater<int>());
+
+    std::function<bool(const int &, const int &)> less = [](const int &a, const int &b) { return a > b; };
+
+    auto values = [](const Records &records) {
+        std::vector<int> v;
+        for (auto &r : records)
+            v.push_back(*r);
+        return v;
+    };
+
+    Records merged;
+    gather_merge_sorted<int>(parts, less, 0, merged);
+    CHECK(values(merged) == all);
+
+    // the first ones only, appended
+    Records limited(1, std::make_shared<int>(1000));
+    gather_merge_sorted<int>(parts, less, 21, limited);
+    REQUIRE(limited.size() == 21);
+    std::vector<int> first = values(limited);
+    CHECK(first[0] == 1000);
+    CHECK(std::vector<int>(first.begin() + 1, first.end()) == std::vector<int>(all.begin(), all.begin() + 20));
+
+    Records more;
+    gather_merge_sorted<int>(parts, less, all.size() + 10, more);
+    CHECK(more.size() == all.size());
+
+    std::vector<Records> none(3);
+    Records empty;
+    gather_merge_sorted<int>(none, less, 10, empty);
+    CHECK(empty.empty());
+}
+
+TEST_CASE("gather clause limit", "[Gather]") {
+    CHECK_FALSE(gather_has_limit(""));
+    CHECK_FALSE(gather_has_limit("WHERE AGE>10 ORDER BY AGE"));
+    CHECK(gather_has_limit("ORDER BY AGE LIMIT 10"));
+    CHECK(gather_has_limit("order by age limit 5, 10"));
+    CHECK(gather_has_limit("LIMIT 1"));
+    CHECK(gather_has_limit("WHERE ID=1\nLIMIT\t1"));
+
+    // not the keyword
+    CHECK_FALSE(gather_has_limit("WHERE LIMITED=1"));
+    CHECK_FALSE(gather_has_limit("WHERE NOLIMIT=1"));
+    CHECK_FALSE(gather_has_limit("WHERE MAX_LIMIT=1"));
+    CHECK_FALSE(gather_has_limit("WHERE NAME='no LIMIT here'"));
+    CHECK_FALSE(gather_has_limit("WHERE NAME=\"it\\\" LIMIT 1\""));
+    CHECK_FALSE(gather_has_limit("WHERE `LIMIT`=1"));
+    CHECK_FALSE(gather_has_limit("WHERE ID IN (SELECT ID FROM T ORDER BY ID LIMIT 10)"));
+    CHECK(gather_has_limit("WHERE ID IN (SELECT ID FROM T LIMIT 10) LIMIT 5"));
+}
+
+TEST_CASE("shard batch partitioning and retries", "[Batch]") {
+    std::vector<int> rows(25);
+    for (size_t i = 0; i < rows.size(); ++i)
+        rows[i] = (int) i;
+
+    // owner i % 3, the rows of shard 1 also dual-written to shard 4
+    ShardBatch<int> batch;
+    for (auto &row : rows) {
+        int ids[2] = {row % 3, 4};
+        batch.add(&row, ids, row % 3 == 1 ? 2 : 1);
+    }
+    batch.build(false, 4);
+
+    auto &statements = batch.statements();
+    REQUIRE(statements.size() == 4);
+    CHECK(statements.at(0).size() == 3);    // 9 rows
+    CHECK(statements.at(1).size() == 2);    // 8 rows
+    CHECK(statements.at(2).size() == 2);    // 8 rows
+    REQUIRE(statements.at(4).size() == 2);  // the 8 rows of shard 1
+
+    for (auto &it : statements) {
+        for (auto &statement : it.second) {
+            CHECK(statement.rows.size() <= 4);
+            CHECK(statement.primary == (it.first != 4));
+            CHECK(statement.replace == !statement.primary);
+            for (auto row : statement.rows)
+                CHECK((it.first == 4 ? 1 : it.first) == *row % 3);
+        }
+    }
+    CHECK(*statements.at(0)[0].rows[0] == 0);
+    CHECK(*statements.at(0)[2].rows[0] == 24);
+    CHECK(*statements.at(4)[1].rows[3] == 22);
+    CHECK(batch.pending() == std::vector<int>({0, 1, 2, 4}));
+
+    // shard 2's first statement fails twice, shard 4 fails always
+    std::map<int, int> failures;
+    std::vector<int> order;
+    auto writer = [&](int shard) {
+        return [&, shard](const ShardBatch<int>::Statement &statement) {
+            if (shard == 4 || (shard == 2 && *statement.rows[0] == 2 && failures[shard]++ < 2))
+                return false;
+            for (auto row : statement.rows)
+                order.push_back(*row);
+            return true;
+        };
+    };
+
+    size_t written = 0;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        for (int shard : batch.pending()) {
+            bool ok = false;
+            written += batch.run(shard, writer(shard), ok);
+            CHECK(ok == (shard == 0 || shard == 1 || (shard == 2 && attempt == 2)));
+        }
+
+        if (attempt == 0)
+            CHECK(batch.pending() == std::vector<int>({2, 4}));
+    }
+
+    CHECK(written == rows.size());
+    CHECK(batch.pending() == std::vector<int>({4}));
+    CHECK(batch.written(2, 0));
+    CHECK_FALSE(batch.written(4, 0));
+    CHECK_FALSE(batch.written(5, 0));
+
+    // every row written once
+    std::sort(order.begin(), order.end());
+    CHECK(order == rows);
+
+    bool ok = false;
+    CHECK(batch.run(7, writer(7), ok) == 0);
+    CHECK(ok);
+}
+
+TEST_CASE("shard batch phases", "[Batch]") {
+    std::vector<int> rows(12);
+    for (size_t i = 0; i < rows.size(); ++i)
+        rows[i] = (int) i;
+
+    // owner i % 2, the odd rows move to shard 0, the even ones to shard 2
+    ShardBatch<int> batch;
+    for (auto &row : rows) {
+        int ids[2] = {row % 2, row % 2 ? 0 : 2};
+        batch.add(&row, ids, 2);
+    }
+    batch.build(false, 100);
+
+    typedef ShardBatch<int> Batch;
+    CHECK(batch.pending(Batch::kPhase_Primary) == std::vector<int>({0, 1}));
+    CHECK(batch.pending(Batch::kPhase_Dual) == std::vector<int>({0, 2}));
+
+    std::vector<std::pair<int, bool> > order;
+    auto writer = [&](int shard) {
+        return [&, shard](const Batch::Statement &statement) {
+            order.push_back(std::make_pair(shard, statement.primary));
+            return true;
+        };
+    };
+
+    // shard 0 has both, only the phase's run
+    bool ok = false;
+    CHECK(batch.run(0, writer(0), ok, Batch::kPhase_Primary) == 6);
+    CHECK(ok);
+    CHECK(batch.run(1, writer(1), ok, Batch::kPhase_Primary) == 6);
+    CHECK(batch.pending(Batch::kPhase_Primary).empty());
+    CHECK(batch.pending() == std::vector<int>({0, 2}));
+
+    CHECK(batch.run(0, writer(0), ok, Batch::kPhase_Dual) == 6);
+    CHECK(batch.run(2, writer(2), ok, Batch::kPhase_Dual) == 6);
+    CHECK(batch.pending().empty());
+
+    REQUIRE(order.size() == 4);
+    CHECK(order[0] == std::make_pair(0, true));
+    CHECK(order[1] == std::make_pair(1, true));
+    CHECK(order[2] == std::make_pair(0, false));
+    CHECK(order[3] == std::make_pair(2, false));
+}